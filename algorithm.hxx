@@ -0,0 +1,486 @@
+#ifndef ALGORITHM_HXX
+#define ALGORITHM_HXX
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <iterator.hxx>
+#include <simd_impl.hxx>
+
+
+namespace cmb {
+
+//
+// enumeration fp_order
+
+// Whether reductions over floating-point values must combine the elements
+// strictly in order, or may reassociate them so they can be vectorized.
+CMB_EXPORT enum class fp_order { strict, reassociate };
+
+
+namespace detail {
+
+//
+// helper concept memmove_copyable
+
+// Copying [first, last) into result can be lowered to a single memmove when
+// both iterators are contiguous over the same trivially copyable, non-volatile
+// value type and the length of the range is known up front.
+template <class I, class S, class O>
+  concept memmove_copyable =
+    cmb::contiguous_iterator<I> and
+    cmb::contiguous_iterator<O> and
+    cmb::detail::non_volatile_iterator<I> and
+    cmb::detail::non_volatile_iterator<O> and
+    cmb::sized_sentinel_for<S, I> and
+    cmb::same_as<std::iter_value_t<I>, std::iter_value_t<O>> and
+    std::is_trivially_copyable_v<std::iter_value_t<I>>;
+
+
+//
+// helper concept memset_fillable
+
+// Filling [first, last) with value can be lowered to a memset when the range
+// is contiguous over a trivially copyable, non-volatile value type and value
+// converts to it the same way for every element.
+template <class O, class S, class T>
+  concept memset_fillable =
+    cmb::contiguous_iterator<O> and
+    cmb::detail::non_volatile_iterator<O> and
+    cmb::sized_sentinel_for<S, O> and
+    std::is_trivially_copyable_v<std::iter_value_t<O>> and
+    ( cmb::same_as<std::remove_cv_t<T>, std::iter_value_t<O>> or
+      ( std::is_scalar_v<T> and std::is_scalar_v<std::iter_value_t<O>> ) );
+
+
+//
+// helper concept memmove_relocatable
+
+// Relocating [first, last) into result can be lowered to a single memmove
+// when both iterators are contiguous over the same trivially relocatable,
+// non-volatile value type and the length of the range is known up front.
+template <class I, class S, class O>
+  concept memmove_relocatable =
+    cmb::contiguous_iterator<I> and
+    cmb::contiguous_iterator<O> and
+    cmb::detail::non_volatile_iterator<I> and
+    cmb::detail::non_volatile_iterator<O> and
+    cmb::sized_sentinel_for<S, I> and
+    cmb::same_as<std::iter_value_t<I>, std::iter_value_t<O>> and
+    cmb::trivially_relocatable<std::iter_value_t<I>>;
+
+
+//
+// helper function memmove_n
+
+template <class I, class O>
+  O memmove_n(I first, std::iter_difference_t<I> n, O result)
+  {
+    if (n > 0)
+      std::memmove(std::to_address(result),
+                   std::to_address(first),
+                   static_cast<std::size_t>(n) * sizeof(std::iter_value_t<I>));
+    return result + n;
+  }
+
+
+//
+// helper function walk_segments
+
+// Calls f(local_first, local_last) on the part of [first, last) within each
+// segment, in order. f returns the local iterator where it stopped; if that
+// is not local_last, the walk ends and the matching position is returned.
+template <class I, class F>
+  constexpr I walk_segments(I first, I last, F f)
+  {
+    using traits = cmb::segmented_iterator_traits<I>;
+
+    auto sfirst      = traits::segment(first);
+    auto const slast = traits::segment(last);
+    if (sfirst == slast)
+      return traits::compose(sfirst, f(traits::local(first), traits::local(last)));
+
+    auto stop = traits::end(sfirst);
+    auto r    = f(traits::local(first), stop);
+    if (r != stop)
+      return traits::compose(sfirst, r);
+
+    for (++sfirst; sfirst != slast; ++sfirst) {
+      stop = traits::end(sfirst);
+      r    = f(traits::begin(sfirst), stop);
+      if (r != stop)
+        return traits::compose(sfirst, r);
+    }
+    return traits::compose(slast, f(traits::begin(slast), traits::local(last)));
+  }
+
+} // namespace detail
+
+
+//
+// Non-modifying sequence algorithms
+// Segmented iterators are walked one segment at a time, so the inner loops
+// run over local iterators without checking for segment boundaries.
+
+// function for_each
+CMB_EXPORT template <class I, class S, class F>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::indirectly_unary_invocable<F, I>
+  constexpr F for_each(I first, S last, F f)
+  {
+    if constexpr (cmb::segmented_iterator<I> and cmb::same_as<S, I>) {
+      cmb::detail::walk_segments(first, last, [&](auto lfirst, auto llast) {
+        for (; lfirst != llast; ++lfirst)
+          std::invoke(f, *lfirst);
+        return llast;
+      });
+    }
+    else {
+      for (; first != last; ++first)
+        std::invoke(f, *first);
+    }
+    return f;
+  }
+
+
+//
+// Copy and move algorithms
+
+// function copy
+CMB_EXPORT template <class I, class S, class O>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::weakly_incrementable<O> and
+           cmb::indirectly_copyable<I, O>
+  constexpr O copy(I first, S last, O result)
+  {
+    if constexpr (cmb::detail::memmove_copyable<I, S, O> and
+                  cmb::indirectly_copyable_storable<I, O>) {
+      if (not std::is_constant_evaluated())
+        return cmb::detail::memmove_n(first, last - first, result);
+    }
+    else if constexpr (cmb::segmented_iterator<I> and cmb::same_as<S, I>) {
+      cmb::detail::walk_segments(first, last, [&](auto lfirst, auto llast) {
+        result = cmb::copy(lfirst, llast, result);
+        return llast;
+      });
+      return result;
+    }
+    for (; first != last; ++first, (void) ++result)
+      *result = *first;
+    return result;
+  }
+
+
+// function move
+CMB_EXPORT template <class I, class S, class O>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::weakly_incrementable<O> and
+           cmb::indirectly_movable<I, O>
+  constexpr O move(I first, S last, O result)
+  {
+    if constexpr (cmb::detail::memmove_copyable<I, S, O> and
+                  cmb::indirectly_movable_storable<I, O>) {
+      if (not std::is_constant_evaluated())
+        return cmb::detail::memmove_n(first, last - first, result);
+    }
+    for (; first != last; ++first, (void) ++result)
+      *result = std::ranges::iter_move(first);
+    return result;
+  }
+
+
+//
+// Fill algorithms
+
+// function fill
+CMB_EXPORT template <class O, class S, class T>
+  requires cmb::output_iterator<O, T const&> and
+           cmb::sentinel_for<S, O>
+  constexpr O fill(O first, S last, T const& value)
+  {
+    if constexpr (cmb::detail::memset_fillable<O, S, T>) {
+      if (not std::is_constant_evaluated()) {
+        using V = std::iter_value_t<O>;
+
+        V const v = value;
+        unsigned char bytes[sizeof(V)];
+        std::memcpy(bytes, &v, sizeof(V));
+
+        // memset can only reproduce values whose bytes are all the same
+        bool uniform = true;
+        for (std::size_t i = 1; i < sizeof(V); ++i)
+          uniform = uniform and bytes[i] == bytes[0];
+
+        if (uniform) {
+          auto const n = last - first;
+          if (n > 0)
+            std::memset(std::to_address(first), bytes[0],
+                        static_cast<std::size_t>(n) * sizeof(V));
+          return first + n;
+        }
+      }
+    }
+    for (; first != last; ++first)
+      *first = value;
+    return first;
+  }
+
+
+//
+// Uninitialized memory algorithms
+
+// function uninitialized_copy
+CMB_EXPORT template <class I, class S, class O>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::forward_iterator<O> and
+           std::is_lvalue_reference_v<std::iter_reference_t<O>> and
+           cmb::same_as<std::remove_cvref_t<std::iter_reference_t<O>>,
+                        std::iter_value_t<O>> and
+           cmb::constructible_from<std::iter_value_t<O>, std::iter_reference_t<I>>
+  O uninitialized_copy(I first, S last, O result)
+  {
+    if constexpr (cmb::detail::memmove_copyable<I, S, O> and
+                  cmb::indirectly_copyable_storable<I, O>) {
+      return cmb::detail::memmove_n(first, last - first, result);
+    }
+    else {
+      O current = result;
+      try {
+        for (; first != last; ++first, (void) ++current)
+          ::new (static_cast<void*>(std::addressof(*current)))
+            std::iter_value_t<O>(*first);
+        return current;
+      }
+      catch (...) {
+        for (; result != current; ++result)
+          std::destroy_at(std::addressof(*result));
+        throw;
+      }
+    }
+  }
+
+
+// function relocate
+// Move constructs *dest from *source and ends the lifetime of *source.
+CMB_EXPORT template <class T>
+  requires cmb::move_constructible<T>
+  T* relocate(T* source, T* dest)
+  {
+    if constexpr (cmb::trivially_relocatable<T>) {
+      std::memmove(static_cast<void*>(dest), static_cast<void const*>(source), sizeof(T));
+    }
+    else {
+      ::new (static_cast<void*>(dest)) T(std::move(*source));
+      std::destroy_at(source);
+    }
+    return dest;
+  }
+
+
+// function uninitialized_relocate
+// Move constructs the elements of [first, last) into the uninitialized
+// storage beginning at result and ends the lifetime of the source elements.
+// If a move constructor throws, the elements constructed so far are
+// destroyed and the source elements stay alive, but those already moved
+// from are left in their moved-from state.
+CMB_EXPORT template <class I, class S, class O>
+  requires cmb::forward_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::forward_iterator<O> and
+           std::is_lvalue_reference_v<std::iter_reference_t<I>> and
+           std::is_lvalue_reference_v<std::iter_reference_t<O>> and
+           cmb::same_as<std::remove_cvref_t<std::iter_reference_t<O>>,
+                        std::iter_value_t<O>> and
+           cmb::constructible_from<std::iter_value_t<O>, std::iter_rvalue_reference_t<I>>
+  O uninitialized_relocate(I first, S last, O result)
+  {
+    if constexpr (cmb::detail::memmove_relocatable<I, S, O>) {
+      return cmb::detail::memmove_n(first, last - first, result);
+    }
+    else {
+      I source  = first;
+      O current = result;
+      try {
+        for (; source != last; ++source, (void) ++current)
+          ::new (static_cast<void*>(std::addressof(*current)))
+            std::iter_value_t<O>(std::ranges::iter_move(source));
+      }
+      catch (...) {
+        for (; result != current; ++result)
+          std::destroy_at(std::addressof(*result));
+        throw;
+      }
+      for (; first != last; ++first)
+        std::destroy_at(std::addressof(*first));
+      return current;
+    }
+  }
+
+
+
+//
+// Search algorithms
+// Contiguous ranges of integral and floating-point values are searched with
+// vectorized kernels selected at run time; segmented ranges are searched one
+// segment at a time; other ranges use a scalar loop.
+
+// function find
+CMB_EXPORT template <class I, class S, class T>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::detail::weakly_equality_comparable_with<std::iter_reference_t<I>, T const&> and
+           cmb::detail::simd_range<I, S> and
+           cmb::same_as<T, std::iter_value_t<I>>
+  constexpr I find(I first, S last, T const& value)
+  {
+    if (std::is_constant_evaluated()) {
+      for (; first != last; ++first)
+        if (*first == value)
+          break;
+      return first;
+    }
+    auto const n = static_cast<std::size_t>(last - first);
+    auto const i = cmb::detail::dispatch<cmb::detail::find_kernel>(std::to_address(first), n, value);
+    return first + static_cast<std::iter_difference_t<I>>(i);
+  }
+
+CMB_EXPORT template <class I, class S, class T>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::detail::weakly_equality_comparable_with<std::iter_reference_t<I>, T const&>
+  constexpr I find(I first, S last, T const& value)
+  {
+    if constexpr (cmb::segmented_iterator<I> and cmb::same_as<S, I>) {
+      return cmb::detail::walk_segments(first, last, [&](auto lfirst, auto llast) {
+        return cmb::find(lfirst, llast, value);
+      });
+    }
+    else {
+      for (; first != last; ++first)
+        if (*first == value)
+          break;
+      return first;
+    }
+  }
+
+
+// function count
+CMB_EXPORT template <class I, class S, class T>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::detail::weakly_equality_comparable_with<std::iter_reference_t<I>, T const&>
+  constexpr std::iter_difference_t<I> count(I first, S last, T const& value)
+  {
+    std::iter_difference_t<I> n = 0;
+    for (; first != last; ++first)
+      if (*first == value)
+        ++n;
+    return n;
+  }
+
+CMB_EXPORT template <class I, class S, class T>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::detail::weakly_equality_comparable_with<std::iter_reference_t<I>, T const&> and
+           cmb::detail::simd_range<I, S> and
+           cmb::same_as<T, std::iter_value_t<I>>
+  constexpr std::iter_difference_t<I> count(I first, S last, T const& value)
+  {
+    if (std::is_constant_evaluated()) {
+      std::iter_difference_t<I> n = 0;
+      for (; first != last; ++first)
+        if (*first == value)
+          ++n;
+      return n;
+    }
+    auto const n = static_cast<std::size_t>(last - first);
+    return static_cast<std::iter_difference_t<I>>(
+      cmb::detail::dispatch<cmb::detail::count_kernel>(std::to_address(first), n, value));
+  }
+
+
+//
+// Minimum and maximum algorithms
+// The range must not be empty. Integral values are always vectorized;
+// floating-point values only with fp_order::reassociate, since the
+// vectorized kernels may pick a different element when the range holds NaN.
+
+// function min_value
+CMB_EXPORT template <class I, class S>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::totally_ordered<std::iter_value_t<I>> and
+           cmb::copyable<std::iter_value_t<I>>
+  constexpr std::iter_value_t<I> min_value(I first, S last, cmb::fp_order = cmb::fp_order::strict)
+  {
+    std::iter_value_t<I> r = *first;
+    for (++first; first != last; ++first)
+      if (*first < r)
+        r = *first;
+    return r;
+  }
+
+CMB_EXPORT template <class I, class S>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::totally_ordered<std::iter_value_t<I>> and
+           cmb::copyable<std::iter_value_t<I>> and
+           cmb::detail::simd_range<I, S>
+  constexpr std::iter_value_t<I> min_value(I first, S last, cmb::fp_order order = cmb::fp_order::strict)
+  {
+    if (std::is_constant_evaluated() or
+        ( cmb::floating_point<std::iter_value_t<I>> and order == cmb::fp_order::strict )) {
+      std::iter_value_t<I> r = *first;
+      for (++first; first != last; ++first)
+        if (*first < r)
+          r = *first;
+      return r;
+    }
+    auto const n = static_cast<std::size_t>(last - first);
+    return cmb::detail::dispatch<cmb::detail::min_kernel>(std::to_address(first), n);
+  }
+
+
+// function max_value
+CMB_EXPORT template <class I, class S>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::totally_ordered<std::iter_value_t<I>> and
+           cmb::copyable<std::iter_value_t<I>>
+  constexpr std::iter_value_t<I> max_value(I first, S last, cmb::fp_order = cmb::fp_order::strict)
+  {
+    std::iter_value_t<I> r = *first;
+    for (++first; first != last; ++first)
+      if (r < *first)
+        r = *first;
+    return r;
+  }
+
+CMB_EXPORT template <class I, class S>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::totally_ordered<std::iter_value_t<I>> and
+           cmb::copyable<std::iter_value_t<I>> and
+           cmb::detail::simd_range<I, S>
+  constexpr std::iter_value_t<I> max_value(I first, S last, cmb::fp_order order = cmb::fp_order::strict)
+  {
+    if (std::is_constant_evaluated() or
+        ( cmb::floating_point<std::iter_value_t<I>> and order == cmb::fp_order::strict )) {
+      std::iter_value_t<I> r = *first;
+      for (++first; first != last; ++first)
+        if (r < *first)
+          r = *first;
+      return r;
+    }
+    auto const n = static_cast<std::size_t>(last - first);
+    return cmb::detail::dispatch<cmb::detail::max_kernel>(std::to_address(first), n);
+  }
+
+} // namespace cmb
+
+
+#endif
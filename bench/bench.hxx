@@ -0,0 +1,94 @@
+#ifndef BENCH_BENCH_HXX
+#define BENCH_BENCH_HXX
+
+#include <algorithm>
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+
+
+namespace bench {
+
+//
+// Timing helpers shared by the runtime benchmarks
+
+// function do_not_optimize
+template <class T>
+  inline void do_not_optimize(T const& value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+
+// function measure
+// Runs f repeatedly for at least min_seconds and returns the fastest run.
+template <class F>
+  double measure(F&& f, double min_seconds = 0.2)
+  {
+    using clock = std::chrono::steady_clock;
+
+    double best  = 1e300;
+    double total = 0.0;
+    int    runs  = 0;
+    while (total < min_seconds or runs < 3) {
+      auto const start = clock::now();
+      f();
+      std::chrono::duration<double> const elapsed = clock::now() - start;
+      best   = std::min(best, elapsed.count());
+      total += elapsed.count();
+      ++runs;
+    }
+    return best;
+  }
+
+
+// function gbps
+inline double gbps(std::size_t bytes, double seconds)
+{
+  return static_cast<double>(bytes) / seconds / 1e9;
+}
+
+
+//
+// class template wrapped_iterator
+// A contiguous iterator over T* that is not a pointer, standing in for the
+// wrapped pointer iterators that miss the standard library's fast paths.
+
+template <class T>
+  struct wrapped_iterator {
+    using iterator_concept  = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = std::remove_cv_t<T>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+
+    pointer p = nullptr;
+
+    reference operator*()  const { return *p; }
+    pointer   operator->() const { return p; }
+    reference operator[](difference_type n) const { return p[n]; }
+
+    wrapped_iterator& operator++() { ++p; return *this; }
+    wrapped_iterator& operator--() { --p; return *this; }
+    wrapped_iterator  operator++(int) { auto t = *this; ++p; return t; }
+    wrapped_iterator  operator--(int) { auto t = *this; --p; return t; }
+
+    wrapped_iterator& operator+=(difference_type n) { p += n; return *this; }
+    wrapped_iterator& operator-=(difference_type n) { p -= n; return *this; }
+
+    friend wrapped_iterator operator+(wrapped_iterator i, difference_type n) { return { i.p + n }; }
+    friend wrapped_iterator operator+(difference_type n, wrapped_iterator i) { return { i.p + n }; }
+    friend wrapped_iterator operator-(wrapped_iterator i, difference_type n) { return { i.p - n }; }
+    friend difference_type  operator-(wrapped_iterator i, wrapped_iterator j) { return i.p - j.p; }
+
+    friend bool operator==(wrapped_iterator const&, wrapped_iterator const&) = default;
+    friend auto operator<=>(wrapped_iterator const&, wrapped_iterator const&) = default;
+  };
+
+} // namespace bench
+
+
+#endif
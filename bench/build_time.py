@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+#
+# Build-time benchmark for the ways of consuming the library.
+#
+# Generates --units translation units that each check a handful of cmb
+# concepts, and builds them three ways:
+#
+#   include       #include <iterator.hxx>
+#   header-unit   import <iterator.hxx>;
+#   module        import cmb.iterator;
+#
+# The cold build compiles the header unit or module interface units (where
+# needed) followed by every translation unit; the incremental build edits a
+# single translation unit and recompiles it. Before timing a mode, one
+# generated translation unit with a main function is linked and run; a mode
+# whose program fails to build or run is reported as broken and not timed.
+#
+#   usage: bench/build_time.py [--cxx g++] [--units 50]
+
+import argparse
+import os
+import pathlib
+import subprocess
+import sys
+import tempfile
+import time
+
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+
+PRELUDE = {
+  'include':     '#include <string>\n#include <vector>\n#include <iterator.hxx>\n',
+  'header-unit': '#include <string>\n#include <vector>\nimport <iterator.hxx>;\n',
+  'module':      '#include <string>\n#include <vector>\nimport cmb.iterator;\n',
+}
+
+UNIT = '''
+namespace unit{n} {{
+  struct record {{
+    int key;
+    double value;
+
+    friend bool operator==(record const&, record const&) = default;
+    friend auto operator<=>(record const&, record const&) = default;
+  }};
+
+  static_assert(cmb::regular<record>);
+  static_assert(cmb::totally_ordered<record>);
+  static_assert(cmb::sortable<std::vector<record>::iterator>);
+  static_assert(cmb::indirectly_copyable_storable<record*, record*>);
+
+  int tag() {{ return {n}; }}
+}}
+'''
+
+MAIN = '''
+int main()
+{{
+  std::vector<unit{n}::record> v{{ {{ 3, 0.5 }}, {{ 1, 1.5 }}, {{ 2, 2.5 }} }};
+  v.push_back({{ 4, 3.5 }});
+  std::string const s = std::to_string(v[3].key) + "th record";
+  return v.size() == 4 and v[0].key == 3 and v[3].value == 3.5 and s == "4th record" ? 0 : 1;
+}}
+'''
+
+
+def run(cmd, cwd):
+  proc = subprocess.run(cmd, cwd=cwd, capture_output=True, text=True)
+  if proc.returncode != 0:
+    sys.exit(f'command failed: {" ".join(cmd)}\n{proc.stderr}')
+
+
+def compiler(cxx, mode):
+  base = [cxx, '-std=c++20', f'-I{ROOT}']
+  if mode != 'include':
+    base += ['-fmodules-ts']
+  return base
+
+
+def interfaces(base, mode, workdir):
+  if mode == 'header-unit':
+    run(base + ['-fmodule-header=system', '-x', 'c++-system-header', 'iterator.hxx'], workdir)
+  elif mode == 'module':
+    for unit in ('concepts.cxx', 'iterator.cxx'):
+      run(base + ['-c', str(ROOT / unit), '-o', unit.replace('.cxx', '.o')], workdir)
+
+
+# Returns None when the program builds and runs, otherwise why it does not.
+def check(cxx, mode, workdir):
+  base = compiler(cxx, mode)
+
+  interfaces(base, mode, workdir)
+  src = workdir / 'main.cxx'
+  src.write_text(PRELUDE[mode] + UNIT.format(n=0) + MAIN.format(n=0))
+  objects = ['concepts.o', 'iterator.o'] if mode == 'module' else []
+  proc = subprocess.run(base + [str(src)] + objects + ['-o', 'main'],
+                        cwd=workdir, capture_output=True, text=True)
+  if proc.returncode != 0:
+    error = next((line for line in proc.stderr.splitlines() if 'error' in line), 'failed')
+    return f'broken, main.cxx does not build: {error.strip()}'
+  proc = subprocess.run([str(workdir / 'main')], cwd=workdir)
+  if proc.returncode != 0:
+    return f'broken, main.cxx exits with status {proc.returncode}'
+  return None
+
+
+def build(cxx, mode, units, workdir):
+  base = compiler(cxx, mode)
+
+  sources = []
+  for n in range(units):
+    src = workdir / f'unit{n}.cxx'
+    src.write_text(PRELUDE[mode] + UNIT.format(n=n))
+    sources.append(src)
+
+  start = time.perf_counter()
+  interfaces(base, mode, workdir)
+  for src in sources:
+    run(base + ['-c', str(src), '-o', src.with_suffix('.o').name], workdir)
+  cold = time.perf_counter() - start
+
+  sources[0].write_text(sources[0].read_text() + '\nint edited() { return 0; }\n')
+  start = time.perf_counter()
+  run(base + ['-c', str(sources[0]), '-o', sources[0].with_suffix('.o').name], workdir)
+  incremental = time.perf_counter() - start
+
+  return cold, incremental
+
+
+def main():
+  parser = argparse.ArgumentParser(
+    description='build-time benchmark for #include vs header units vs modules')
+  parser.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+  parser.add_argument('--units', type=int, default=50,
+                      help='number of generated translation units')
+  parser.add_argument('modes', nargs='*', default=list(PRELUDE))
+  args = parser.parse_args()
+
+  print(f'compiler: {args.cxx}, translation units: {args.units}')
+  print(f'{"mode":<12} {"cold (s)":>9} {"incremental (s)":>16}')
+
+  broken = False
+  for mode in args.modes:
+    with tempfile.TemporaryDirectory() as tmp:
+      failure = check(args.cxx, mode, pathlib.Path(tmp))
+    if failure:
+      print(f'{mode:<12} {failure}')
+      broken = True
+      continue
+    with tempfile.TemporaryDirectory() as tmp:
+      cold, incremental = build(args.cxx, mode, args.units, pathlib.Path(tmp))
+      print(f'{mode:<12} {cold:>9.2f} {incremental:>16.2f}')
+
+  sys.exit(1 if broken else 0)
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,46 @@
+// Translation unit compiled by compile_time.py. Checks CMB_BENCH_EXPR for
+// CMB_BENCH_COUNT distinct synthetic types T and iterators I.
+//
+//   CMB_BENCH_STD    use <concepts>/<iterator> instead of the cmb headers
+//   CMB_BENCH_EXPR   concept expression in terms of T and I
+//   CMB_BENCH_COUNT  number of synthetic types to check
+
+#include <utility>
+
+#ifdef CMB_BENCH_STD
+  #include <concepts>
+  #include <iterator>
+#else
+  #include <concepts.hxx>
+  #include <iterator.hxx>
+#endif
+
+#include "synthetic.hxx"
+
+#ifndef CMB_BENCH_EXPR
+  #define CMB_BENCH_EXPR true
+#endif
+
+#ifndef CMB_BENCH_COUNT
+  #define CMB_BENCH_COUNT 1000
+#endif
+
+
+template <int N>
+  constexpr bool check()
+  {
+    using T = bench::synthetic<N>;
+    using I = bench::synthetic_iterator<N>;
+    return CMB_BENCH_EXPR;
+  }
+
+template <int... Ns>
+  constexpr bool check_all(std::integer_sequence<int, Ns...>)
+  {
+    return (check<Ns>() and ...);
+  }
+
+static_assert(check_all(std::make_integer_sequence<int, CMB_BENCH_COUNT>{}));
+
+
+int main() { }
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+#
+# Compile-time benchmark for the cmb concepts against the matching std
+# concepts.
+#
+# For every concept, compile_time.cxx is compiled once against the cmb
+# headers and once against the standard headers, checking the concept for
+# --count distinct synthetic types. Each row reports the wall time and peak
+# memory of the compiler process, and the number of class template
+# instantiations the check added on top of an empty baseline translation
+# unit. The cmb headers are measured both with the std:: trait backend and
+# with the compiler builtin backend (CMB_USE_BUILTINS). With Clang the
+# instantiation count is read from -ftime-trace; with GCC it is read from
+# the -fdump-lang-class dump.
+#
+#   usage: bench/compile_time.py [--cxx g++] [--count 200] [concept ...]
+
+import argparse
+import json
+import os
+import pathlib
+import shlex
+import subprocess
+import sys
+import tempfile
+import time
+
+
+# library -> (namespace, defines)
+LIBS = {
+  'cmb':          ('cmb', []),
+  'cmb-builtins': ('cmb', ['-DCMB_USE_BUILTINS']),
+  'std':          ('std', ['-DCMB_BENCH_STD']),
+}
+
+ROOT  = pathlib.Path(__file__).resolve().parent.parent
+BENCH = ROOT / 'bench'
+
+# concept -> expression in terms of a synthetic type T and iterator I
+CONCEPTS = {
+  'same_as':                    '{ns}::same_as<T, T>',
+  'convertible_to':             '{ns}::convertible_to<T, T const&>',
+  'copyable':                   '{ns}::copyable<T>',
+  'regular':                    '{ns}::regular<T>',
+  'totally_ordered':            '{ns}::totally_ordered<T>',
+  'random_access_iterator':     '{ns}::random_access_iterator<I>',
+  'contiguous_iterator':        '{ns}::contiguous_iterator<I>',
+  'indirect_strict_weak_order': '{ns}::indirect_strict_weak_order<std::ranges::less, I>',
+  'sortable':                   '{ns}::sortable<I>',
+}
+
+
+def is_clang(cxx):
+  out = subprocess.run([cxx, '--version'], capture_output=True, text=True).stdout
+  return 'clang' in out
+
+
+def compile_once(cxx, flags, expr, count, lib, clang, workdir):
+  cmd  = [cxx, '-std=c++20', f'-I{ROOT}', f'-I{BENCH}', *flags, *LIBS[lib][1],
+          f'-DCMB_BENCH_EXPR={expr}', f'-DCMB_BENCH_COUNT={count}']
+
+  obj  = workdir / 'bench.o'
+  dump = workdir / 'bench.class'
+  if clang:
+    cmd += ['-c', '-o', str(obj), '-ftime-trace', '-ftime-trace-granularity=0']
+  else:
+    cmd += ['-fsyntax-only', f'-fdump-lang-class={dump}']
+  cmd += [str(BENCH / 'compile_time.cxx')]
+
+  # Diagnostics go to a file rather than a pipe: wait4 collects the rusage
+  # of the compiler, and a pipe nobody drains would block it once full.
+  log = workdir / 'bench.log'
+  with log.open('w') as stderr:
+    start = time.perf_counter()
+    proc  = subprocess.Popen(cmd, stderr=stderr)
+    _, status, usage = os.wait4(proc.pid, 0)
+    wall  = time.perf_counter() - start
+
+  if status != 0:
+    sys.exit(f'compilation failed: {shlex.join(cmd)}\n{log.read_text()}')
+
+  if clang:
+    trace = json.loads(obj.with_suffix('.json').read_text())
+    count = sum(1 for e in trace['traceEvents']
+                if e.get('name') in ('InstantiateClass', 'InstantiateFunction'))
+  else:
+    count = sum(1 for line in dump.read_text().splitlines()
+                if line.startswith('Class '))
+
+  return wall, usage.ru_maxrss / 1024.0, count
+
+
+def main():
+  parser = argparse.ArgumentParser(
+    description='compile-time benchmark for cmb concepts vs std concepts')
+  parser.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+  parser.add_argument('--count', type=int, default=200,
+                      help='synthetic types checked per translation unit')
+  parser.add_argument('--flags', default='',
+                      help='extra compiler flags, e.g. "-O2"')
+  parser.add_argument('--libs', default=','.join(LIBS),
+                      help='comma-separated subset of ' + ', '.join(LIBS))
+  parser.add_argument('concepts', nargs='*', default=list(CONCEPTS))
+  args = parser.parse_args()
+
+  clang = is_clang(args.cxx)
+  flags = shlex.split(args.flags)
+  libs  = args.libs.split(',')
+
+  print(f'compiler: {args.cxx}, types per TU: {args.count}')
+  print(f'{"concept":<28} {"lib":<13} {"wall (s)":>9} {"peak (MiB)":>11} {"instantiations":>15}')
+
+  with tempfile.TemporaryDirectory() as tmp:
+    workdir = pathlib.Path(tmp)
+    baseline = { }
+    for lib in libs:
+      base = compile_once(args.cxx, flags, 'true', args.count, lib, clang, workdir)
+      baseline[lib] = base[2]
+      print(f'{"(baseline)":<28} {lib:<13} {base[0]:>9.2f} {base[1]:>11.1f} {base[2]:>15}')
+
+    for name in args.concepts:
+      for lib in libs:
+        expr = CONCEPTS[name].format(ns=LIBS[lib][0])
+        wall, mem, count = compile_once(args.cxx, flags, expr, args.count, lib, clang, workdir)
+        print(f'{name:<28} {lib:<13} {wall:>9.2f} {mem:>11.1f} {count - baseline[lib]:>15}')
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,76 @@
+// Runtime benchmark for cmb::copy, cmb::move and cmb::fill against the
+// std::ranges algorithms on mixed iterator types.
+//
+//   g++ -std=c++20 -O2 -I. bench/copy.cxx -o bench_copy && ./bench_copy
+
+#include <cstdint>
+#include <ranges>
+#include <vector>
+#include <algorithm.hxx>
+#include "bench.hxx"
+
+
+template <class T, class MakeIn, class MakeOut>
+  void compare_copy(char const* name, std::size_t n, MakeIn make_in, MakeOut make_out)
+  {
+    std::vector<T> src(n, T{ 1 });
+    std::vector<T> dst(n);
+
+    auto first = make_in(src.data());
+    auto last  = make_in(src.data() + n);
+    auto out   = make_out(dst.data());
+
+    double const t_cmb = bench::measure([&] {
+      cmb::copy(first, last, out);
+      bench::do_not_optimize(dst.data());
+    });
+    double const t_std = bench::measure([&] {
+      std::ranges::copy(first, last, out);
+      bench::do_not_optimize(dst.data());
+    });
+
+    std::size_t const bytes = n * sizeof(T);
+    std::printf("copy  %-28s %10zu %10.2f %10.2f\n", name, bytes,
+                bench::gbps(bytes, t_cmb), bench::gbps(bytes, t_std));
+  }
+
+
+template <class T, class Make>
+  void compare_fill(char const* name, std::size_t n, Make make)
+  {
+    std::vector<T> dst(n);
+
+    auto first = make(dst.data());
+    auto last  = make(dst.data() + n);
+
+    double const t_cmb = bench::measure([&] {
+      cmb::fill(first, last, T{ 0 });
+      bench::do_not_optimize(dst.data());
+    });
+    double const t_std = bench::measure([&] {
+      std::ranges::fill(first, last, T{ 0 });
+      bench::do_not_optimize(dst.data());
+    });
+
+    std::size_t const bytes = n * sizeof(T);
+    std::printf("fill  %-28s %10zu %10.2f %10.2f\n", name, bytes,
+                bench::gbps(bytes, t_cmb), bench::gbps(bytes, t_std));
+  }
+
+
+int main()
+{
+  auto pointer = [](auto* p) { return p; };
+  auto wrapped = [](auto* p) { return bench::wrapped_iterator<std::remove_pointer_t<decltype(p)>>{ p }; };
+
+  std::printf("%-34s %10s %10s %10s\n", "algorithm", "bytes", "cmb GB/s", "std GB/s");
+  for (std::size_t n : { std::size_t{ 1 } << 10, std::size_t{ 1 } << 16, std::size_t{ 1 } << 22 }) {
+    compare_copy<std::int32_t>("pointer -> pointer", n, pointer, pointer);
+    compare_copy<std::int32_t>("wrapped -> pointer", n, wrapped, pointer);
+    compare_copy<std::int32_t>("pointer -> wrapped", n, pointer, wrapped);
+    compare_copy<std::int32_t>("wrapped -> wrapped", n, wrapped, wrapped);
+    compare_copy<double>      ("wrapped -> wrapped (double)", n, wrapped, wrapped);
+    compare_fill<std::int32_t>("pointer", n, pointer);
+    compare_fill<std::int32_t>("wrapped", n, wrapped);
+  }
+}
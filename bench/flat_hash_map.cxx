@@ -0,0 +1,147 @@
+// Runtime benchmark for cmb::flat_hash_map against std::unordered_map.
+// Reports insertion, successful lookup and failed lookup throughput in
+// millions of operations per second, and the heap memory per entry after
+// the insertions, counted by replacing the global operator new.
+//
+//   g++ -std=c++20 -O2 -I. bench/flat_hash_map.cxx -o bench_flat_hash_map && ./bench_flat_hash_map
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <malloc.h>
+#include <flat_hash_map.hxx>
+#include "bench.hxx"
+
+
+//
+// Heap accounting
+// Counts the usable size of every live allocation, which includes the
+// allocator's rounding but not its headers.
+
+static std::size_t live_bytes = 0;
+
+static void* counted_alloc(std::size_t n, std::size_t alignment)
+{
+  void* p = alignment <= alignof(std::max_align_t)
+          ? std::malloc(n == 0 ? 1 : n)
+          : std::aligned_alloc(alignment, (n + alignment - 1) / alignment * alignment);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  live_bytes += malloc_usable_size(p);
+  return p;
+}
+
+static void counted_free(void* p) noexcept
+{
+  if (p != nullptr) {
+    live_bytes -= malloc_usable_size(p);
+    std::free(p);
+  }
+}
+
+void* operator new(std::size_t n) { return counted_alloc(n, 1); }
+void* operator new[](std::size_t n) { return counted_alloc(n, 1); }
+void* operator new(std::size_t n, std::align_val_t a) { return counted_alloc(n, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return counted_alloc(n, static_cast<std::size_t>(a)); }
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+
+
+//
+// Workloads
+
+template <class Map, class K>
+  void run(char const* map, char const* type, std::vector<K> const& keys, std::vector<K> const& absent)
+  {
+    std::size_t const n = keys.size();
+    double const ops    = static_cast<double>(n) / 1e6;
+
+    double const t_insert = bench::measure([&] {
+      Map m;
+      for (auto const& k : keys)
+        m[k] = 1;
+      bench::do_not_optimize(m.size());
+    });
+
+    std::size_t const before = live_bytes;
+    Map m;
+    for (auto const& k : keys)
+      m[k] = 1;
+    double const bytes = static_cast<double>(live_bytes - before) / static_cast<double>(n);
+
+    std::vector<K> shuffled(keys);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(7));
+
+    double const t_hit = bench::measure([&] {
+      std::size_t found = 0;
+      for (auto const& k : shuffled)
+        found += m.find(k) != m.end();
+      bench::do_not_optimize(found);
+    });
+
+    double const t_miss = bench::measure([&] {
+      std::size_t found = 0;
+      for (auto const& k : absent)
+        found += m.find(k) != m.end();
+      bench::do_not_optimize(found);
+    });
+
+    std::printf("%-14s %-8s %9zu %10.1f %10.1f %10.1f %12.1f\n", map, type, n,
+                ops / t_insert, ops / t_hit, ops / t_miss, bytes);
+  }
+
+
+template <class K>
+  K make_key(std::uint64_t x);
+
+template <>
+  std::uint64_t make_key<std::uint64_t>(std::uint64_t x) { return x; }
+
+// longer than the small-string buffer, as most identifiers in lookup tables are
+template <>
+  std::string make_key<std::string>(std::uint64_t x) { return "key-" + std::to_string(x) + "-0123456789"; }
+
+
+template <class K>
+  void run_type(char const* type, std::size_t n)
+  {
+    std::mt19937_64 rng(n);
+    std::vector<K> keys, absent;
+    keys.reserve(n);
+    absent.reserve(n);
+    // even values are inserted and odd values looked up as absent keys
+    for (std::size_t i = 0; i < n; ++i) {
+      std::uint64_t const x = rng() & ~std::uint64_t{ 1 };
+      keys.push_back(make_key<K>(x));
+      absent.push_back(make_key<K>(x | 1));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    run<cmb::flat_hash_map<K, std::uint32_t>>("flat_hash_map", type, keys, absent);
+    run<std::unordered_map<K, std::uint32_t>>("unordered_map", type, keys, absent);
+  }
+
+
+int main()
+{
+  std::printf("%-14s %-8s %9s %10s %10s %10s %12s\n",
+              "map", "key", "entries", "insert/us", "hit/us", "miss/us", "bytes/entry");
+  for (std::size_t n : { std::size_t{ 1 } << 10, std::size_t{ 1 } << 16, std::size_t{ 1 } << 20, std::size_t{ 1 } << 22 }) {
+    run_type<std::uint64_t>("uint64", n);
+    run_type<std::string>  ("string", n);
+  }
+}
@@ -0,0 +1,114 @@
+// Runtime benchmark for the cmb::parallel algorithms against the standard
+// algorithms with std::execution::par, from one thread up to every hardware
+// thread. Reports milliseconds and speedup over the serial std:: algorithm.
+// libstdc++ runs std::execution::par on TBB, whose thread count is capped
+// with tbb::global_control.
+//
+//   g++ -std=c++20 -O2 -I. bench/parallel.cxx -o bench_parallel -ltbb -pthread && ./bench_parallel
+
+#include <algorithm>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include <tbb/global_control.h>
+#include <parallel.hxx>
+#include "bench.hxx"
+
+
+template <class F, class G>
+  void compare(char const* op, std::size_t threads, double serial, F cmb_op, G std_op)
+  {
+    double const t_cmb = bench::measure(cmb_op, 0.5);
+    double const t_std = bench::measure(std_op, 0.5);
+    std::printf("%-18s %8zu %10.2f %10.2f %10.2f %10.2f\n", op, threads,
+                t_cmb * 1e3, t_std * 1e3, serial / t_cmb, serial / t_std);
+  }
+
+
+int main()
+{
+  std::size_t const n     = std::size_t{ 1 } << 24;
+  std::size_t const cores = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::uint32_t> input(n);
+  std::mt19937 rng(42);
+  for (auto& x : input)
+    x = static_cast<std::uint32_t>(rng());
+
+  std::vector<std::uint32_t> a(input.begin(), input.begin() + n / 2);
+  std::vector<std::uint32_t> b(input.begin() + n / 2, input.end());
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+
+  std::vector<std::uint32_t> work(n);
+  std::vector<std::uint32_t> out(n);
+
+  auto const square = [](std::uint32_t x) { return std::uint64_t{ x } * x; };
+  auto const touch  = [](std::uint32_t& x) { x = x * 2654435761u + 1; };
+
+  double const serial_sort   = bench::measure([&] {
+    work = input;
+    std::sort(work.begin(), work.end());
+  });
+  double const serial_reduce = bench::measure([&] {
+    bench::do_not_optimize(std::transform_reduce(input.begin(), input.end(), std::uint64_t{ },
+                                                 std::plus<>{ }, square));
+  });
+  double const serial_each   = bench::measure([&] {
+    std::for_each(work.begin(), work.end(), touch);
+    bench::do_not_optimize(work.data());
+  });
+  double const serial_merge  = bench::measure([&] {
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+    bench::do_not_optimize(out.data());
+  });
+
+  std::printf("%-18s %8s %10s %10s %10s %10s\n",
+              "algorithm", "threads", "cmb ms", "par ms", "cmb x", "par x");
+  for (std::size_t threads = 1; threads <= cores; ++threads) {
+    cmb::parallel::thread_pool pool(threads);
+    tbb::global_control limit(tbb::global_control::max_allowed_parallelism, threads);
+
+    // both sides pay for the copy that restores the unsorted input
+    compare("sort", threads, serial_sort,
+            [&] {
+              work = input;
+              cmb::parallel::sort(pool, work.begin(), work.end());
+            },
+            [&] {
+              work = input;
+              std::sort(std::execution::par, work.begin(), work.end());
+            });
+    compare("transform_reduce", threads, serial_reduce,
+            [&] {
+              bench::do_not_optimize(cmb::parallel::transform_reduce(
+                pool, input.begin(), input.end(), std::uint64_t{ }, std::plus<>{ }, square));
+            },
+            [&] {
+              bench::do_not_optimize(std::transform_reduce(
+                std::execution::par, input.begin(), input.end(), std::uint64_t{ }, std::plus<>{ }, square));
+            });
+    compare("for_each", threads, serial_each,
+            [&] {
+              cmb::parallel::for_each(pool, work.begin(), work.end(), touch);
+              bench::do_not_optimize(work.data());
+            },
+            [&] {
+              std::for_each(std::execution::par, work.begin(), work.end(), touch);
+              bench::do_not_optimize(work.data());
+            });
+    compare("merge", threads, serial_merge,
+            [&] {
+              cmb::parallel::merge(pool, a.begin(), a.end(), b.begin(), b.end(), out.begin());
+              bench::do_not_optimize(out.data());
+            },
+            [&] {
+              std::merge(std::execution::par, a.begin(), a.end(), b.begin(), b.end(), out.begin());
+              bench::do_not_optimize(out.data());
+            });
+  }
+}
@@ -0,0 +1,191 @@
+// Runtime benchmark for the segmented overloads of cmb::for_each, cmb::find
+// and cmb::copy on a chunked buffer, against flat iteration by the std
+// algorithms over the same iterators.
+//
+//   g++ -std=c++20 -O2 -I. bench/segmented.cxx -o bench_segmented && ./bench_segmented
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <algorithm.hxx>
+#include "bench.hxx"
+
+
+namespace bench {
+
+//
+// class template chunked_iterator
+// Random access iterator over a chunked_buffer: a pointer into the array of
+// chunks and a pointer to the current element within that chunk.
+
+template <class T, std::size_t C>
+  class chunked_iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+
+    chunked_iterator() = default;
+    chunked_iterator(T* const* chunk, T* cur) : chunk_{ chunk }, cur_{ cur } { }
+
+    reference operator*()  const { return *cur_; }
+    pointer   operator->() const { return cur_; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    chunked_iterator& operator++()
+    {
+      if (++cur_ == *chunk_ + C)
+        cur_ = *++chunk_;
+      return *this;
+    }
+
+    chunked_iterator& operator--()
+    {
+      if (cur_ == *chunk_)
+        cur_ = *--chunk_ + C;
+      --cur_;
+      return *this;
+    }
+
+    chunked_iterator operator++(int) { auto t = *this; ++*this; return t; }
+    chunked_iterator operator--(int) { auto t = *this; --*this; return t; }
+
+    chunked_iterator& operator+=(difference_type n)
+    {
+      difference_type const offset = (cur_ - *chunk_) + n;
+      difference_type const chunks = offset >= 0 ? offset / difference_type(C)
+                                                 : -((-offset - 1) / difference_type(C)) - 1;
+      chunk_ += chunks;
+      cur_    = *chunk_ + (offset - chunks * difference_type(C));
+      return *this;
+    }
+
+    chunked_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    friend chunked_iterator operator+(chunked_iterator i, difference_type n) { return i += n; }
+    friend chunked_iterator operator+(difference_type n, chunked_iterator i) { return i += n; }
+    friend chunked_iterator operator-(chunked_iterator i, difference_type n) { return i -= n; }
+
+    friend difference_type operator-(chunked_iterator const& a, chunked_iterator const& b)
+    {
+      return (a.chunk_ - b.chunk_) * difference_type(C) +
+             (a.cur_ - *a.chunk_) - (b.cur_ - *b.chunk_);
+    }
+
+    friend bool operator==(chunked_iterator const& a, chunked_iterator const& b)
+    {
+      return a.cur_ == b.cur_;
+    }
+
+    friend auto operator<=>(chunked_iterator const& a, chunked_iterator const& b)
+    {
+      if (auto c = a.chunk_ <=> b.chunk_; c != 0)
+        return c;
+      return a.cur_ <=> b.cur_;
+    }
+
+    T* const* chunk() const { return chunk_; }
+    T*        cur()   const { return cur_; }
+
+  private:
+    T* const* chunk_ = nullptr;
+    T*        cur_   = nullptr;
+  };
+
+
+//
+// class template chunked_buffer
+// A fixed-size sequence stored in chunks of C elements. One spare chunk is
+// kept past the last element, so end() points into an allocated chunk.
+
+template <class T, std::size_t C>
+  class chunked_buffer {
+  public:
+    using iterator = bench::chunked_iterator<T, C>;
+
+    explicit chunked_buffer(std::size_t n)
+      : size_{ n }
+    {
+      for (std::size_t i = 0; i < n / C + 1; ++i)
+        chunks_.push_back(new T[C]{ });
+    }
+
+    chunked_buffer(chunked_buffer const&) = delete;
+    chunked_buffer& operator=(chunked_buffer const&) = delete;
+
+    ~chunked_buffer()
+    {
+      for (T* chunk : chunks_)
+        delete[] chunk;
+    }
+
+    iterator begin() const { return { chunks_.data(), chunks_[0] }; }
+    iterator end()   const { return { chunks_.data() + size_ / C, chunks_[size_ / C] + size_ % C }; }
+
+  private:
+    std::vector<T*> chunks_;
+    std::size_t     size_;
+  };
+
+} // namespace bench
+
+
+template <class T, std::size_t C>
+  struct cmb::segmented_iterator_traits<bench::chunked_iterator<T, C>> {
+    using iterator         = bench::chunked_iterator<T, C>;
+    using segment_iterator = T* const*;
+    using local_iterator   = T*;
+
+    static segment_iterator segment(iterator i) { return i.chunk(); }
+    static local_iterator   local(iterator i)   { return i.cur(); }
+    static local_iterator   begin(segment_iterator s) { return *s; }
+    static local_iterator   end(segment_iterator s)   { return *s + C; }
+    static iterator         compose(segment_iterator s, local_iterator l) { return { s, l }; }
+  };
+
+
+int main()
+{
+  constexpr std::size_t chunk = 4096;
+  using buffer = bench::chunked_buffer<std::int32_t, chunk>;
+
+  static_assert(cmb::random_access_iterator<buffer::iterator>);
+  static_assert(cmb::segmented_iterator<buffer::iterator>);
+
+  std::printf("%-10s %12s %14s %14s\n", "algorithm", "bytes", "segmented GB/s", "flat GB/s");
+  for (std::size_t n : { std::size_t{ 1 } << 14, std::size_t{ 1 } << 20, std::size_t{ 1 } << 24 }) {
+    buffer b(n);
+    std::int32_t i = 0;
+    cmb::for_each(b.begin(), b.end(), [&](std::int32_t& x) { x = i++ % 1000 + 1; });
+
+    std::vector<std::int32_t> out(n);
+    std::size_t const bytes = n * sizeof(std::int32_t);
+
+    auto report = [&](char const* name, double t_seg, double t_flat) {
+      std::printf("%-10s %12zu %14.2f %14.2f\n", name, bytes,
+                  bench::gbps(bytes, t_seg), bench::gbps(bytes, t_flat));
+    };
+
+    report("for_each",
+      bench::measure([&] {
+        std::int64_t sum = 0;
+        cmb::for_each(b.begin(), b.end(), [&](std::int32_t x) { sum += x; });
+        bench::do_not_optimize(sum);
+      }),
+      bench::measure([&] {
+        std::int64_t sum = 0;
+        std::for_each(b.begin(), b.end(), [&](std::int32_t x) { sum += x; });
+        bench::do_not_optimize(sum);
+      }));
+
+    report("find",
+      bench::measure([&] { bench::do_not_optimize(cmb::find(b.begin(), b.end(), 0)); }),
+      bench::measure([&] { bench::do_not_optimize(std::find(b.begin(), b.end(), 0)); }));
+
+    report("copy",
+      bench::measure([&] { cmb::copy(b.begin(), b.end(), out.data()); bench::do_not_optimize(out.data()); }),
+      bench::measure([&] { std::copy(b.begin(), b.end(), out.data()); bench::do_not_optimize(out.data()); }));
+  }
+}
@@ -0,0 +1,65 @@
+// Runtime benchmark for the vectorized reduction and search kernels against
+// the matching standard algorithms. Reports GB/s by element type and size.
+//
+//   g++ -std=c++20 -O2 -I. bench/simd.cxx -o bench_simd && ./bench_simd
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include <numeric.hxx>
+#include "bench.hxx"
+
+
+template <class F, class G>
+  void compare(char const* op, char const* type, std::size_t bytes, F cmb_op, G std_op)
+  {
+    double const t_cmb = bench::measure(cmb_op, 0.1);
+    double const t_std = bench::measure(std_op, 0.1);
+    std::printf("%-18s %-8s %10zu %10.2f %10.2f\n", op, type, bytes,
+                bench::gbps(bytes, t_cmb), bench::gbps(bytes, t_std));
+  }
+
+
+template <class T>
+  void run(char const* type, std::size_t bytes)
+  {
+    std::size_t const n = bytes / sizeof(T);
+    std::vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+      v[i] = static_cast<T>(i % 97 + 1);
+
+    auto const first = v.begin();
+    auto const last  = v.end();
+    T const absent   = T{ 0 };
+
+    compare("sum", type, bytes,
+            [&] { bench::do_not_optimize(cmb::sum(first, last)); },
+            [&] { bench::do_not_optimize(std::accumulate(first, last, T{ })); });
+    if constexpr (cmb::floating_point<T>)
+      compare("sum reassociate", type, bytes,
+              [&] { bench::do_not_optimize(cmb::sum(first, last, cmb::fp_order::reassociate)); },
+              [&] { bench::do_not_optimize(std::reduce(first, last, T{ })); });
+    compare("min", type, bytes,
+            [&] { bench::do_not_optimize(cmb::min_value(first, last, cmb::fp_order::reassociate)); },
+            [&] { bench::do_not_optimize(*std::min_element(first, last)); });
+    compare("find", type, bytes,
+            [&] { bench::do_not_optimize(cmb::find(first, last, absent)); },
+            [&] { bench::do_not_optimize(std::find(first, last, absent)); });
+    compare("count", type, bytes,
+            [&] { bench::do_not_optimize(cmb::count(first, last, T{ 1 })); },
+            [&] { bench::do_not_optimize(std::count(first, last, T{ 1 })); });
+  }
+
+
+int main()
+{
+  std::printf("%-18s %-8s %10s %10s %10s\n", "kernel", "type", "bytes", "cmb GB/s", "std GB/s");
+  for (std::size_t bytes : { std::size_t{ 1 } << 12, std::size_t{ 1 } << 18, std::size_t{ 1 } << 26 }) {
+    run<std::int8_t> ("int8",   bytes);
+    run<std::int32_t>("int32",  bytes);
+    run<std::int64_t>("int64",  bytes);
+    run<float>       ("float",  bytes);
+    run<double>      ("double", bytes);
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef BENCH_SYNTHETIC_HXX
+#define BENCH_SYNTHETIC_HXX
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+
+
+namespace bench {
+
+//
+// Synthetic types used by the compile-time benchmarks. Every value of N
+// yields a distinct type, so each concept check is a fresh instantiation.
+
+// class template synthetic
+template <int N>
+  struct synthetic {
+    int value;
+
+    friend bool operator==(synthetic const&, synthetic const&) = default;
+    friend auto operator<=>(synthetic const&, synthetic const&) = default;
+  };
+
+
+// class template synthetic_iterator
+template <int N>
+  struct synthetic_iterator {
+    using iterator_concept  = std::contiguous_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = bench::synthetic<N>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+
+    pointer p = nullptr;
+
+    reference operator*()  const { return *p; }
+    pointer   operator->() const { return p; }
+    reference operator[](difference_type n) const { return p[n]; }
+
+    synthetic_iterator& operator++() { ++p; return *this; }
+    synthetic_iterator& operator--() { --p; return *this; }
+    synthetic_iterator  operator++(int) { auto t = *this; ++p; return t; }
+    synthetic_iterator  operator--(int) { auto t = *this; --p; return t; }
+
+    synthetic_iterator& operator+=(difference_type n) { p += n; return *this; }
+    synthetic_iterator& operator-=(difference_type n) { p -= n; return *this; }
+
+    friend synthetic_iterator operator+(synthetic_iterator i, difference_type n) { return { i.p + n }; }
+    friend synthetic_iterator operator+(difference_type n, synthetic_iterator i) { return { i.p + n }; }
+    friend synthetic_iterator operator-(synthetic_iterator i, difference_type n) { return { i.p - n }; }
+    friend difference_type    operator-(synthetic_iterator i, synthetic_iterator j) { return i.p - j.p; }
+
+    friend bool operator==(synthetic_iterator const&, synthetic_iterator const&) = default;
+    friend auto operator<=>(synthetic_iterator const&, synthetic_iterator const&) = default;
+  };
+
+} // namespace bench
+
+
+#endif
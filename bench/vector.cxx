@@ -0,0 +1,90 @@
+// Runtime benchmark for cmb::vector against std::vector on a move-only
+// handle type that opts in to cmb::trivially_relocatable. Reports push_back
+// throughput and the peak resident memory of a process that fills one
+// container.
+//
+//   g++ -std=c++20 -O2 -I. bench/vector.cxx -o bench_vector && ./bench_vector
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector.hxx>
+#include "bench.hxx"
+
+
+namespace bench {
+
+//
+// class handle
+// A move-only owner of an integer resource. Moving leaves the source empty,
+// so std::vector pays a move-construct and a destroy per element on growth.
+
+long released = 0;
+
+class handle {
+public:
+  explicit handle(long id) noexcept : id_{ id } { }
+  handle(handle&& other) noexcept : id_{ std::exchange(other.id_, -1) } { }
+  handle& operator=(handle&& other) noexcept { std::swap(id_, other.id_); return *this; }
+  ~handle() { if (id_ >= 0) released += id_; }
+
+  long id() const noexcept { return id_; }
+
+private:
+  long id_;
+};
+
+} // namespace bench
+
+template <>
+  inline constexpr bool cmb::enable_trivially_relocatable<bench::handle> = true;
+
+
+template <class Vector>
+  void fill(std::size_t n)
+  {
+    Vector v;
+    for (std::size_t i = 0; i < n; ++i)
+      v.emplace_back(static_cast<long>(i));
+    bench::do_not_optimize(v.data());
+  }
+
+
+// Fills one container in a child process and returns its peak RSS in MiB.
+template <class Vector>
+  double peak_memory(std::size_t n)
+  {
+    pid_t const pid = fork();
+    if (pid == 0) {
+      fill<Vector>(n);
+      _exit(0);
+    }
+    int status = 0;
+    rusage usage { };
+    wait4(pid, &status, 0, &usage);
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+  }
+
+
+int main()
+{
+  using cmb_vector = cmb::vector<bench::handle>;
+  using std_vector = std::vector<bench::handle>;
+
+  std::printf("%10s %14s %14s %12s %12s\n",
+              "elements", "cmb Mpush/s", "std Mpush/s", "cmb MiB", "std MiB");
+  for (std::size_t n : { std::size_t{ 1 } << 10, std::size_t{ 1 } << 16,
+                         std::size_t{ 1 } << 20, std::size_t{ 1 } << 24 }) {
+    double const t_cmb = bench::measure([&] { fill<cmb_vector>(n); });
+    double const t_std = bench::measure([&] { fill<std_vector>(n); });
+
+    std::printf("%10zu %14.1f %14.1f %12.1f %12.1f\n", n,
+                static_cast<double>(n) / t_cmb / 1e6,
+                static_cast<double>(n) / t_std / 1e6,
+                peak_memory<cmb_vector>(n),
+                peak_memory<std_vector>(n));
+  }
+}
@@ -0,0 +1,15 @@
+// Module interface unit for cmb.concepts. Exports the concepts declared in
+// concepts.hxx; names in cmb::detail stay internal to the module.
+//
+//   g++ -std=c++20 -fmodules-ts -I. -c concepts.cxx
+
+module;
+
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+export module cmb.concepts;
+
+#define CMB_EXPORT export
+#include <concepts.hxx>
@@ -1,11 +1,31 @@
 #ifndef CONCEPTS_HXX
 #define CONCEPTS_HXX
 
-#include <functional>
 #include <ranges>
 #include <type_traits>
 #include <utility>
 
+// <functional> is not included: GCC 12 miscompiles programs that import a
+// module whose global module fragment includes it. The callable concepts use
+// the <type_traits> forms of std::invoke.
+
+
+// The cmb.concepts and cmb.iterator module interface units define CMB_EXPORT
+// as export before including the headers; otherwise it expands to nothing.
+#ifndef CMB_EXPORT
+  #define CMB_EXPORT
+#endif
+
+// Defining CMB_USE_BUILTINS selects an implementation of the core concepts
+// that evaluates the compiler's type-trait builtins directly instead of
+// instantiating the corresponding std:: trait class templates. Builtins the
+// compiler does not provide fall back to the std:: traits.
+#if defined(CMB_USE_BUILTINS) and defined(__has_builtin)
+  #define CMB_HAS_BUILTIN(x) __has_builtin(x)
+#else
+  #define CMB_HAS_BUILTIN(x) 0
+#endif
+
 
 namespace cmb {
 
@@ -16,33 +36,49 @@ namespace cmb {
 namespace detail
 {
   template <class T, class U>
+#if CMB_HAS_BUILTIN(__is_same)
+    concept same_as_impl = __is_same(T, U);
+#else
     concept same_as_impl = std::is_same_v<T, U>;
+#endif
 }
 
-template <class T, class U>
+CMB_EXPORT template <class T, class U>
   concept same_as =
     cmb::detail::same_as_impl<T, U> and
     cmb::detail::same_as_impl<U, T>;
 
 
 // concept derived_from
-template <class Derived, class Base>
+CMB_EXPORT template <class Derived, class Base>
   concept derived_from =
+#if CMB_HAS_BUILTIN(__is_base_of)
+    __is_base_of(Base, Derived) and
+#else
     std::is_base_of_v<Base, Derived> and
+#endif
+#if CMB_HAS_BUILTIN(__is_convertible)
+    __is_convertible(Derived const volatile*, Base const volatile*);
+#else
     std::is_convertible_v<Derived const volatile*, Base const volatile*>;
+#endif
 
 
 // concept convertible_to
-template <class From, class To>
+CMB_EXPORT template <class From, class To>
   concept convertible_to =
+#if CMB_HAS_BUILTIN(__is_convertible)
+    __is_convertible(From, To) and
+#else
     std::is_convertible_v<From, To> and
+#endif
     requires(std::add_rvalue_reference_t<From>(&f)()) {
       static_cast<To>(f());
     };
 
 
 // concept common_reference_with
-template <class T, class U>
+CMB_EXPORT template <class T, class U>
   concept common_reference_with =
     cmb::same_as<
       std::common_reference_t<T, U>,
@@ -52,7 +88,7 @@ template <class T, class U>
 
 
 // concept common_with
-template <class T, class U>
+CMB_EXPORT template <class T, class U>
   concept common_with =
     cmb::same_as<
       std::common_type_t<T, U>,
@@ -72,33 +108,37 @@ template <class T, class U>
 
 
 // concept integral
-template <class T>
+CMB_EXPORT template <class T>
   concept integral = std::is_integral_v<T>;
 
 
 // concept signed_integral
-template <class T>
+CMB_EXPORT template <class T>
   concept signed_integral =
     cmb::integral<T> and
     std::is_signed_v<T>;
 
 
 // concept unsigned_integral
-template <class T>
+CMB_EXPORT template <class T>
   concept unsigned_integral =
     cmb::integral<T> and
     not std::is_signed_v<T>;
 
 
 // concept floating_point
-template <class T>
+CMB_EXPORT template <class T>
   concept floating_point = std::is_floating_point_v<T>;
 
 
 // concept assignable_from
-template <class LHS, class RHS>
+CMB_EXPORT template <class LHS, class RHS>
   concept assignable_from =
+#if CMB_HAS_BUILTIN(__is_lvalue_reference)
+    __is_lvalue_reference(LHS) and
+#else
     std::is_lvalue_reference_v<LHS> and
+#endif
     cmb::common_reference_with<
       std::remove_reference_t<LHS> const&,
       std::remove_reference_t<RHS> const&> and
@@ -108,7 +148,7 @@ template <class LHS, class RHS>
 
 
 // concept swappable
-template <class T>
+CMB_EXPORT template <class T>
   concept swappable =
     requires(T& a, T& b) {
       std::ranges::swap(a, b);
@@ -116,7 +156,7 @@ template <class T>
 
 
 // concept swappable_with
-template <class T, class U>
+CMB_EXPORT template <class T, class U>
   concept swappable_with =
     cmb::common_reference_with<T, U> and
     requires(T&& t, U&& u) {
@@ -128,19 +168,27 @@ template <class T, class U>
 
 
 // concept destructible
-template <class T>
+CMB_EXPORT template <class T>
+#if CMB_HAS_BUILTIN(__is_nothrow_destructible)
+  concept destructible = __is_nothrow_destructible(T);
+#else
   concept destructible = std::is_nothrow_destructible_v<T>;
+#endif
 
 
 // concept constructible_from
-template <class T, class... Args>
+CMB_EXPORT template <class T, class... Args>
   concept constructible_from =
     cmb::destructible<T> and
+#if CMB_HAS_BUILTIN(__is_constructible)
+    __is_constructible(T, Args...);
+#else
     std::is_constructible_v<T, Args...>;
+#endif
 
 
 // concept default_initializable
-template <class T>
+CMB_EXPORT template <class T>
   concept default_initializable =
     cmb::constructible_from<T> and
     requires {
@@ -150,14 +198,14 @@ template <class T>
 
 
 // concept move_constructible
-template <class T>
+CMB_EXPORT template <class T>
   concept move_constructible =
     cmb::constructible_from<T, T> and
     cmb::convertible_to<T, T>;
 
 
 // concept copy_constructible
-template <class T>
+CMB_EXPORT template <class T>
   concept copy_constructible =
     cmb::move_constructible<T> and
     cmb::constructible_from<T, T&> and
@@ -189,7 +237,8 @@ namespace detail
 // concept equality_comparable
 namespace detail
 {
-  template <class T, class U>
+  // exported for the sentinel_for concept of the cmb.iterator module
+  CMB_EXPORT template <class T, class U>
     concept weakly_equality_comparable_with =
       requires(std::remove_reference_t<T> const& t,
                std::remove_reference_t<U> const& u) {
@@ -200,13 +249,13 @@ namespace detail
       };
 }
 
-template <class T>
+CMB_EXPORT template <class T>
   concept equality_comparable =
     cmb::detail::weakly_equality_comparable_with<T, T>;
 
 
 // concept equality_comparable_with
-template <class T, class U>
+CMB_EXPORT template <class T, class U>
   concept equality_comparable_with =
     cmb::equality_comparable<T> and
     cmb::equality_comparable<U> and
@@ -238,14 +287,14 @@ namespace detail
       };
 }
 
-template <class T>
+CMB_EXPORT template <class T>
   concept totally_ordered =
     cmb::equality_comparable<T> and
     cmb::detail::partially_ordered_with<T, T>;
 
 
 // concept totally_ordered_with
-template <class T, class U>
+CMB_EXPORT template <class T, class U>
   concept totally_ordered_with =
     cmb::totally_ordered<T> and
     cmb::totally_ordered<U> and
@@ -261,16 +310,41 @@ template <class T, class U>
 // Object concepts
 
 // concept movable
-template <class T>
+CMB_EXPORT template <class T>
   concept movable =
+#if CMB_HAS_BUILTIN(__is_object)
+    __is_object(T) and
+#else
     std::is_object_v<T> and
+#endif
     cmb::move_constructible<T> and
     cmb::assignable_from<T&, T> and
     cmb::swappable<T>;
 
 
+// variable template enable_trivially_relocatable
+// Specialize as true for types whose move construction followed by the
+// destruction of the source is equivalent to copying their bytes.
+CMB_EXPORT template <class T>
+  inline constexpr bool enable_trivially_relocatable =
+    std::is_trivially_move_constructible_v<T> and
+    std::is_trivially_destructible_v<T>;
+
+
+// concept trivially_relocatable
+CMB_EXPORT template <class T>
+  concept trivially_relocatable =
+#if CMB_HAS_BUILTIN(__is_object)
+    __is_object(T) and
+#else
+    std::is_object_v<T> and
+#endif
+    cmb::move_constructible<T> and
+    cmb::enable_trivially_relocatable<std::remove_cv_t<T>>;
+
+
 // concept copyable
-template <class T>
+CMB_EXPORT template <class T>
   concept copyable =
     cmb::copy_constructible<T> and
     cmb::movable<T> and
@@ -280,44 +354,63 @@ template <class T>
 
 
 // concept semiregular
-template <class T>
+CMB_EXPORT template <class T>
   concept semiregular =
     cmb::copyable<T> and
     cmb::default_initializable<T>;
 
 
 // concept regular
-template <class T>
+CMB_EXPORT template <class T>
   concept regular =
     cmb::semiregular<T> and
     cmb::equality_comparable<T>;
 
 
+// concept hashable
+// H maps values of T to std::size_t; values that compare equal must hash
+// equal. H has no default: naming std::hash here makes GCC 12 fail on
+// programs that import cmb.concepts and use std::string.
+CMB_EXPORT template <class T, class H>
+  concept hashable =
+    cmb::equality_comparable<T> and
+    std::is_invocable_v<H const&, std::remove_reference_t<T> const&> and
+    cmb::same_as<std::invoke_result_t<H const&, std::remove_reference_t<T> const&>, std::size_t>;
+
+
+// concept hashable_with
+// Values of K can stand in for values of T in a lookup keyed on T: they
+// compare with them through equality_comparable_with, and H hashes a K to
+// the same value as every T it compares equal to.
+CMB_EXPORT template <class K, class T, class H>
+  concept hashable_with =
+    cmb::hashable<T, H> and
+    cmb::hashable<K, H> and
+    cmb::equality_comparable_with<K, T>;
+
+
 //
 // Callable concepts
 
 // concept invocable
-template <class F, class... Args>
-  concept invocable =
-    requires(F&& f, Args&&... args) {
-      std::invoke(std::forward<F>(f), std::forward<Args>(args)...);
-  };
+CMB_EXPORT template <class F, class... Args>
+  concept invocable = std::is_invocable_v<F, Args...>;
 
 
 // concept regular_invocable
-template <class F, class... Args>
+CMB_EXPORT template <class F, class... Args>
   concept regular_invocable = cmb::invocable<F, Args...>;
 
 
 // concept predicate
-template <class F, class... Args>
+CMB_EXPORT template <class F, class... Args>
   concept predicate =
     cmb::regular_invocable<F, Args...> and
     cmb::detail::boolean_testable<std::invoke_result_t<F, Args...>>;
 
 
 // concept relation
-template <class R, class T, class U>
+CMB_EXPORT template <class R, class T, class U>
   concept relation =
     cmb::predicate<R, T, T> and
     cmb::predicate<R, U, U> and
@@ -326,15 +419,19 @@ template <class R, class T, class U>
 
 
 // concept equivalence_relation
-template <class R, class T, class U>
+CMB_EXPORT template <class R, class T, class U>
   concept equivalence_relation = cmb::relation<R, T, U>;
 
 
 // concept strict_weak_order
-template <class R, class T, class U>
+CMB_EXPORT template <class R, class T, class U>
   concept strict_weak_order = cmb::relation<R, T, U>;
 
 } // namespace cmb
 
 
+// CMB_HAS_BUILTIN is internal to this header
+#undef CMB_HAS_BUILTIN
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,687 @@
+#ifndef FLAT_HASH_MAP_HXX
+#define FLAT_HASH_MAP_HXX
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <algorithm.hxx>
+#include <simd_impl.hxx>
+
+
+namespace cmb    {
+namespace detail {
+
+//
+// Control bytes
+// Every slot of a flat_hash_map has one control byte, stored apart from the
+// slots: empty, deleted, or the low 7 bits of the hash of a full slot's key
+// (h2). Slots are probed in groups of 16 whose control bytes are compared
+// with one SSE2 instruction.
+
+using ctrl_t = signed char;
+
+inline constexpr cmb::detail::ctrl_t ctrl_empty   = -128;
+inline constexpr cmb::detail::ctrl_t ctrl_deleted = -2;
+
+inline constexpr std::size_t group_width = 16;
+
+
+// helper class group
+// Bit i of a mask refers to slot i of the group.
+class group {
+public:
+  explicit group(cmb::detail::ctrl_t const* ctrl) noexcept
+    : ctrl_{ cmb::detail::load<16>(ctrl) }
+  { }
+
+  // slots whose control byte is h2
+  std::uint32_t match(cmb::detail::ctrl_t h2) const noexcept
+  {
+    return mask(ctrl_ == cmb::detail::broadcast<16>(h2));
+  }
+
+  std::uint32_t match_empty() const noexcept
+  {
+    return mask(ctrl_ == cmb::detail::broadcast<16>(cmb::detail::ctrl_empty));
+  }
+
+  // empty and deleted are the only control bytes with the sign bit set
+  std::uint32_t match_empty_or_deleted() const noexcept
+  {
+    return mask(ctrl_);
+  }
+
+private:
+  using vector = cmb::detail::simd_vector<16, cmb::detail::ctrl_t>;
+
+  // gathers the sign bit of every lane
+  static std::uint32_t mask(vector v) noexcept
+  {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+      __builtin_ia32_pmovmskb128(reinterpret_cast<cmb::detail::simd_vector<16, char>&>(v)));
+#else
+    std::uint32_t m = 0;
+    for (std::size_t i = 0; i < cmb::detail::group_width; ++i)
+      m |= static_cast<std::uint32_t>(v[i] < 0) << i;
+    return m;
+#endif
+  }
+
+  vector ctrl_;
+};
+
+
+// helper function mix_hash
+// Spreads the bits of a hash, so that the identity hashes of the standard
+// library fill both the group index (h1) and the control byte (h2).
+inline std::size_t mix_hash(std::size_t h) noexcept
+{
+  std::uint64_t x = static_cast<std::uint64_t>(h) * 0x9e3779b97f4a7c15u;
+  return static_cast<std::size_t>(x ^ (x >> 32));
+}
+
+
+//
+// helper concept transparent
+
+// Hash function objects that opt in to heterogeneous lookup.
+template <class H>
+  concept transparent =
+    requires { typename H::is_transparent; };
+
+} // namespace detail
+
+
+//
+// class template flat_hash_map
+// An open-addressing hash map that stores its elements in one flat array of
+// slots, with the control bytes in a separate array in front of it, so an
+// insertion allocates nothing unless the table grows. Probing visits whole
+// groups of slots by matching their control bytes with SIMD compares, and
+// touches a slot only when its control byte matches the key's hash. Lookups
+// accept any key type that is hashable_with the key type when Hash declares
+// is_transparent. Growing the table relocates the elements, so references
+// and iterators are invalidated by any insertion that grows it.
+
+CMB_EXPORT template <class Key, class T, class Hash = std::hash<Key>>
+  requires cmb::regular<Key> and
+           cmb::hashable<Key, Hash> and
+           cmb::copy_constructible<Hash> and
+           std::is_object_v<T> and
+           cmb::destructible<T>
+  class flat_hash_map {
+    template <bool Const>
+      class iterator_impl;
+
+  public:
+    using key_type        = Key;
+    using mapped_type     = T;
+    using value_type      = std::pair<Key const, T>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = Hash;
+    using reference       = value_type&;
+    using const_reference = value_type const&;
+    using iterator        = iterator_impl<false>;
+    using const_iterator  = iterator_impl<true>;
+
+    flat_hash_map() = default;
+
+    explicit flat_hash_map(Hash hash)
+      : hash_{ std::move(hash) }
+    { }
+
+    flat_hash_map(flat_hash_map const& other)
+      requires cmb::copy_constructible<T>
+      : hash_{ other.hash_ }
+    {
+      try {
+        reserve(other.size_);
+        for (auto const& e : other)
+          emplace_new(hash(e.first), e.first, e.second);
+      }
+      catch (...) {
+        destroy_slots();
+        deallocate(ctrl_, capacity_);
+        throw;
+      }
+    }
+
+    flat_hash_map(flat_hash_map&& other) noexcept
+      : ctrl_{ std::exchange(other.ctrl_, nullptr) },
+        slots_{ std::exchange(other.slots_, nullptr) },
+        capacity_{ std::exchange(other.capacity_, 0) },
+        size_{ std::exchange(other.size_, 0) },
+        growth_left_{ std::exchange(other.growth_left_, 0) },
+        hash_{ other.hash_ }
+    { }
+
+    flat_hash_map& operator=(flat_hash_map const& other)
+      requires cmb::copy_constructible<T>
+    {
+      if (this != &other) {
+        flat_hash_map copy(other);
+        swap(copy);
+      }
+      return *this;
+    }
+
+    flat_hash_map& operator=(flat_hash_map&& other) noexcept
+    {
+      flat_hash_map moved(std::move(other));
+      swap(moved);
+      return *this;
+    }
+
+    ~flat_hash_map()
+    {
+      destroy_slots();
+      deallocate(ctrl_, capacity_);
+    }
+
+    // iterators
+    iterator       begin()       noexcept { return { ctrl_, slots_, ctrl_ + capacity_ }; }
+    const_iterator begin() const noexcept { return { ctrl_, slots_, ctrl_ + capacity_ }; }
+    iterator       end()         noexcept { return { ctrl_ + capacity_, slots_ + capacity_ }; }
+    const_iterator end()   const noexcept { return { ctrl_ + capacity_, slots_ + capacity_ }; }
+
+    // capacity
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    // Makes room for n elements without growing again.
+    void reserve(size_type n)
+    {
+      if (n > size_ + growth_left_)
+        rehash(std::max(capacity_, capacity_for(n)));
+    }
+
+    // lookup
+    iterator find(Key const& key) { return to_iterator(find_index(key)); }
+    const_iterator find(Key const& key) const { return to_iterator(find_index(key)); }
+
+    template <class K>
+      requires cmb::detail::transparent<Hash> and cmb::hashable_with<K, Key, Hash>
+      iterator find(K const& key) { return to_iterator(find_index(key)); }
+
+    template <class K>
+      requires cmb::detail::transparent<Hash> and cmb::hashable_with<K, Key, Hash>
+      const_iterator find(K const& key) const { return to_iterator(find_index(key)); }
+
+    bool contains(Key const& key) const { return find_index(key) != capacity_; }
+
+    template <class K>
+      requires cmb::detail::transparent<Hash> and cmb::hashable_with<K, Key, Hash>
+      bool contains(K const& key) const { return find_index(key) != capacity_; }
+
+    T& at(Key const& key)
+    {
+      size_type const i = find_index(key);
+      if (i == capacity_)
+        throw std::out_of_range("cmb::flat_hash_map::at: key not found");
+      return slots_[i].second;
+    }
+
+    T const& at(Key const& key) const
+    {
+      size_type const i = find_index(key);
+      if (i == capacity_)
+        throw std::out_of_range("cmb::flat_hash_map::at: key not found");
+      return slots_[i].second;
+    }
+
+    T& operator[](Key const& key)
+      requires cmb::default_initializable<T>
+    {
+      return try_emplace(key).first->second;
+    }
+
+    T& operator[](Key&& key)
+      requires cmb::default_initializable<T>
+    {
+      return try_emplace(std::move(key)).first->second;
+    }
+
+    // modifiers
+    // Inserts value_type(key, T(args...)) unless the key is present; args
+    // are not used in that case.
+    template <class... Args>
+      requires cmb::constructible_from<T, Args...>
+      std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+      {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+      }
+
+    template <class... Args>
+      requires cmb::constructible_from<T, Args...>
+      std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+      {
+        return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+      }
+
+    std::pair<iterator, bool> insert(value_type const& value)
+      requires cmb::copy_constructible<T>
+    {
+      return try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+      requires cmb::move_constructible<T>
+    {
+      return try_emplace(value.first, std::move(value.second));
+    }
+
+    template <class M>
+      requires cmb::constructible_from<T, M> and cmb::assignable_from<T&, M>
+      std::pair<iterator, bool> insert_or_assign(Key const& key, M&& value)
+      {
+        auto result = try_emplace(key, std::forward<M>(value));
+        if (not result.second)
+          result.first->second = std::forward<M>(value);
+        return result;
+      }
+
+    size_type erase(Key const& key)
+    {
+      size_type const i = find_index(key);
+      if (i == capacity_)
+        return 0;
+      erase_index(i);
+      return 1;
+    }
+
+    template <class K>
+      requires cmb::detail::transparent<Hash> and cmb::hashable_with<K, Key, Hash>
+      size_type erase(K const& key)
+      {
+        size_type const i = find_index(key);
+        if (i == capacity_)
+          return 0;
+        erase_index(i);
+        return 1;
+      }
+
+    // Erasing leaves the other elements in place, so pos + 1 stays valid.
+    iterator erase(const_iterator pos)
+    {
+      size_type const i = static_cast<size_type>(pos.ctrl_ - ctrl_);
+      erase_index(i);
+      return iterator(ctrl_ + i + 1, slots_ + i + 1, ctrl_ + capacity_);
+    }
+
+    void clear() noexcept
+    {
+      destroy_slots();
+      if (capacity_ != 0)
+        std::memset(ctrl_, cmb::detail::ctrl_empty, capacity_);
+      size_        = 0;
+      growth_left_ = max_load(capacity_);
+    }
+
+    void swap(flat_hash_map& other) noexcept
+    {
+      std::swap(ctrl_, other.ctrl_);
+      std::swap(slots_, other.slots_);
+      std::swap(capacity_, other.capacity_);
+      std::swap(size_, other.size_);
+      std::swap(growth_left_, other.growth_left_);
+      std::swap(hash_, other.hash_);
+    }
+
+    // observers
+    hasher hash_function() const { return hash_; }
+
+  private:
+    template <bool Const>
+      class iterator_impl {
+      public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = flat_hash_map::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using slot_type         = std::conditional_t<Const, value_type const, value_type>;
+        using pointer           = slot_type*;
+        using reference         = slot_type&;
+
+        iterator_impl() noexcept = default;
+
+        // iterator converts to const_iterator
+        template <bool C>
+          requires ( Const and not C )
+          iterator_impl(iterator_impl<C> const& other) noexcept
+            : ctrl_{ other.ctrl_ }, slot_{ other.slot_ }, end_{ other.end_ }
+          { }
+
+        reference operator*()  const noexcept { return *slot_; }
+        pointer   operator->() const noexcept { return slot_; }
+
+        iterator_impl& operator++() noexcept
+        {
+          ++ctrl_;
+          ++slot_;
+          skip_free();
+          return *this;
+        }
+
+        iterator_impl operator++(int) noexcept
+        {
+          auto t = *this;
+          ++*this;
+          return t;
+        }
+
+        friend bool operator==(iterator_impl const& i, iterator_impl const& j) noexcept
+        {
+          return i.slot_ == j.slot_;
+        }
+
+      private:
+        friend flat_hash_map;
+        friend iterator_impl<true>;
+
+        iterator_impl(cmb::detail::ctrl_t const* ctrl, pointer slot) noexcept
+          : ctrl_{ ctrl }, slot_{ slot }
+        { }
+
+        // positions the iterator on the first full slot at or after slot
+        iterator_impl(cmb::detail::ctrl_t const* ctrl, pointer slot,
+                      cmb::detail::ctrl_t const* end) noexcept
+          : ctrl_{ ctrl }, slot_{ slot }, end_{ end }
+        {
+          skip_free();
+        }
+
+        // The control bytes past the table are never read: end() holds no
+        // end_ and compares by slot, and incrementing stops at end_.
+        void skip_free() noexcept
+        {
+          while (ctrl_ != end_ and *ctrl_ < 0) {
+            ++ctrl_;
+            ++slot_;
+          }
+        }
+
+        cmb::detail::ctrl_t const* ctrl_ = nullptr;
+        pointer                    slot_ = nullptr;
+        cmb::detail::ctrl_t const* end_  = nullptr;
+      };
+
+    // The table grows when it would be more than 7/8 full, counting deleted
+    // slots, so every probe sequence reaches an empty slot.
+    static size_type max_load(size_type capacity) noexcept
+    {
+      return capacity - capacity / 8;
+    }
+
+    static size_type capacity_for(size_type n) noexcept
+    {
+      size_type const slots = n + (n + 6) / 7;
+      return std::max(cmb::detail::group_width, std::bit_ceil(slots));
+    }
+
+    iterator to_iterator(size_type i) noexcept
+    {
+      return i == capacity_ ? end() : iterator(ctrl_ + i, slots_ + i, ctrl_ + capacity_);
+    }
+
+    const_iterator to_iterator(size_type i) const noexcept
+    {
+      return i == capacity_ ? end() : const_iterator(ctrl_ + i, slots_ + i, ctrl_ + capacity_);
+    }
+
+    // Groups are probed quadratically (triangular numbers of groups), which
+    // visits every group of a power-of-two table.
+    struct probe_seq {
+      size_type mask;
+      size_type group;
+      size_type step = 0;
+
+      size_type offset() const noexcept { return group * cmb::detail::group_width; }
+
+      void next() noexcept { group = (group + ++step) & mask; }
+    };
+
+    probe_seq probe(std::size_t h) const noexcept
+    {
+      size_type const mask = capacity_ / cmb::detail::group_width - 1;
+      return { mask, (h >> 7) & mask };
+    }
+
+    static cmb::detail::ctrl_t h2(std::size_t h) noexcept
+    {
+      return static_cast<cmb::detail::ctrl_t>(h & 0x7f);
+    }
+
+    std::size_t hash(auto const& key) const
+    {
+      return cmb::detail::mix_hash(std::invoke(hash_, key));
+    }
+
+    // index of the slot holding key, or capacity_
+    template <class K>
+      size_type find_index(K const& key) const
+      {
+        if (size_ == 0)
+          return capacity_;
+        return find_index(key, hash(key));
+      }
+
+    // As above, given h = hash(key).
+    template <class K>
+      size_type find_index(K const& key, std::size_t h) const
+      {
+        if (size_ == 0)
+          return capacity_;
+        for (probe_seq seq = probe(h);; seq.next()) {
+          cmb::detail::group const g(ctrl_ + seq.offset());
+          for (std::uint32_t m = g.match(h2(h)); m != 0; m &= m - 1) {
+            size_type const i = seq.offset() + static_cast<size_type>(std::countr_zero(m));
+            if (key == slots_[i].first)
+              return i;
+          }
+          if (g.match_empty() != 0)
+            return capacity_;
+        }
+      }
+
+    // first empty or deleted slot in the probe sequence of h
+    size_type find_free(std::size_t h) const noexcept
+    {
+      for (probe_seq seq = probe(h);; seq.next()) {
+        cmb::detail::group const g(ctrl_ + seq.offset());
+        if (std::uint32_t const m = g.match_empty_or_deleted(); m != 0)
+          return seq.offset() + static_cast<size_type>(std::countr_zero(m));
+      }
+    }
+
+    // The key is hashed once, for both the lookup and the insertion.
+    template <class K, class... Args>
+      std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args)
+      {
+        std::size_t const h = hash(key);
+        size_type const i = find_index(key, h);
+        if (i != capacity_)
+          return { to_iterator(i), false };
+        return { to_iterator(emplace_new(h, std::forward<K>(key), std::forward<Args>(args)...)), true };
+      }
+
+    // Constructs a new element for a key known to be absent, given
+    // h = hash(key).
+    template <class K, class... Args>
+      size_type emplace_new(std::size_t h, K&& key, Args&&... args)
+      {
+        if (growth_left_ == 0) {
+          // The new element is constructed before the table is rehashed,
+          // since key and args may refer to elements of this map.
+          alignas(value_type) unsigned char storage[sizeof(value_type)];
+          value_type* p = ::new (static_cast<void*>(storage))
+            value_type(std::piecewise_construct,
+                       std::forward_as_tuple(std::forward<K>(key)),
+                       std::forward_as_tuple(std::forward<Args>(args)...));
+          size_type i;
+          try {
+            grow();
+            i = find_free(h);
+            relocate_slot(p, slots_ + i);
+          }
+          catch (...) {
+            std::destroy_at(p);
+            throw;
+          }
+          set_full(i, h);
+          return i;
+        }
+        size_type const i = find_free(h);
+        ::new (static_cast<void*>(slots_ + i))
+          value_type(std::piecewise_construct,
+                     std::forward_as_tuple(std::forward<K>(key)),
+                     std::forward_as_tuple(std::forward<Args>(args)...));
+        set_full(i, h);
+        return i;
+      }
+
+    void set_full(size_type i, std::size_t h) noexcept
+    {
+      if (ctrl_[i] == cmb::detail::ctrl_empty)
+        --growth_left_;
+      ctrl_[i] = h2(h);
+      ++size_;
+    }
+
+    // A slot becomes empty again only if its group still has an empty slot,
+    // since then no probe sequence has ever passed over the group.
+    void erase_index(size_type i) noexcept
+    {
+      std::destroy_at(slots_ + i);
+      --size_;
+      size_type const first = i - i % cmb::detail::group_width;
+      if (cmb::detail::group(ctrl_ + first).match_empty() != 0) {
+        ctrl_[i] = cmb::detail::ctrl_empty;
+        ++growth_left_;
+      }
+      else {
+        ctrl_[i] = cmb::detail::ctrl_deleted;
+      }
+    }
+
+    // Doubles the table, or rehashes it in place at the same capacity when
+    // deleted slots take up most of the room.
+    void grow()
+    {
+      if (capacity_ != 0 and size_ <= max_load(capacity_) / 2)
+        rehash(capacity_);
+      else
+        rehash(capacity_ == 0 ? cmb::detail::group_width : 2 * capacity_);
+    }
+
+    // Moves every element into a new table of the given capacity. Elements
+    // are relocated by copying their bytes only when hashing cannot throw,
+    // since each relocation empties the old slot. Otherwise they are moved
+    // with move_if_noexcept, as std::vector does, so if a move or a hash
+    // throws, the new table is discarded and the map is left unchanged.
+    void rehash(size_type capacity)
+    {
+      auto [ctrl, slots] = allocate(capacity);
+      std::memset(ctrl, cmb::detail::ctrl_empty, capacity);
+
+      flat_hash_map next(hash_);
+      next.ctrl_        = ctrl;
+      next.slots_       = slots;
+      next.capacity_    = capacity;
+      next.growth_left_ = max_load(capacity);
+
+      if constexpr (slot_relocatable and std::is_nothrow_invocable_v<Hash const&, Key const&>) {
+        for (size_type i = 0; i < capacity_; ++i)
+          if (ctrl_[i] >= 0) {
+            std::size_t const h = hash(slots_[i].first);
+            size_type const j = next.find_free(h);
+            relocate_slot(slots_ + i, next.slots_ + j);
+            next.set_full(j, h);
+            ctrl_[i] = cmb::detail::ctrl_empty;
+          }
+      }
+      else {
+        for (size_type i = 0; i < capacity_; ++i)
+          if (ctrl_[i] >= 0) {
+            std::size_t const h = hash(slots_[i].first);
+            size_type const j = next.find_free(h);
+            ::new (static_cast<void*>(next.slots_ + j)) value_type(std::move_if_noexcept(slots_[i]));
+            next.set_full(j, h);
+          }
+      }
+      // next now owns the old table and destroys what is left in it
+      swap(next);
+    }
+
+    // An element is relocated by copying its bytes when both of its members
+    // are trivially relocatable, even though the const key keeps the pair
+    // itself from being trivially move constructible. Otherwise moving it
+    // copies the key.
+    static constexpr bool slot_relocatable =
+      cmb::trivially_relocatable<Key> and cmb::trivially_relocatable<T>;
+
+    static void relocate_slot(value_type* source, value_type* dest)
+    {
+      if constexpr (slot_relocatable)
+        std::memcpy(static_cast<void*>(dest), static_cast<void const*>(source), sizeof(value_type));
+      else
+        cmb::relocate(source, dest);
+    }
+
+    void destroy_slots() noexcept
+    {
+      if constexpr (not std::is_trivially_destructible_v<value_type>) {
+        for (size_type i = 0; i < capacity_; ++i)
+          if (ctrl_[i] >= 0)
+            std::destroy_at(slots_ + i);
+      }
+      size_ = 0;
+    }
+
+    // The control bytes and the slots share one allocation: capacity
+    // control bytes, then the slots at the next multiple of their alignment.
+    static constexpr std::size_t alignment =
+      std::max(cmb::detail::group_width, alignof(value_type));
+
+    static std::size_t slots_offset(size_type capacity) noexcept
+    {
+      return (capacity + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+    }
+
+    static std::pair<cmb::detail::ctrl_t*, value_type*> allocate(size_type capacity)
+    {
+      void* p = ::operator new(slots_offset(capacity) + capacity * sizeof(value_type),
+                               std::align_val_t{ alignment });
+      auto* ctrl = static_cast<cmb::detail::ctrl_t*>(p);
+      return { ctrl, reinterpret_cast<value_type*>(static_cast<unsigned char*>(p) + slots_offset(capacity)) };
+    }
+
+    static void deallocate(cmb::detail::ctrl_t* ctrl, size_type capacity) noexcept
+    {
+      if (ctrl != nullptr)
+        ::operator delete(ctrl, slots_offset(capacity) + capacity * sizeof(value_type),
+                          std::align_val_t{ alignment });
+    }
+
+    cmb::detail::ctrl_t* ctrl_        = nullptr;
+    value_type*          slots_       = nullptr;
+    size_type            capacity_    = 0;
+    size_type            size_        = 0;
+    size_type            growth_left_ = 0;
+    [[no_unique_address]]
+    Hash                 hash_        = Hash();
+  };
+
+} // namespace cmb
+
+
+#endif
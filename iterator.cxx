@@ -0,0 +1,25 @@
+// Module interface unit for cmb.iterator. Exports the concepts declared in
+// iterator.hxx along with those of cmb.concepts; names in cmb::detail stay
+// internal to the module.
+//
+// GCC 12 builds this unit but then fails with an internal compiler error on
+// importers that use std::string; see the Modules section of README.md.
+//
+//   g++ -std=c++20 -fmodules-ts -I. -c concepts.cxx iterator.cxx
+
+module;
+
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+export module cmb.iterator;
+
+export import cmb.concepts;
+
+// concepts.hxx is provided by the cmb.concepts import above
+#define CONCEPTS_HXX
+#define CMB_EXPORT export
+#include <iterator.hxx>
@@ -10,13 +10,13 @@ namespace cmb {
 // Iterator concepts
 
 // concept indirectly_readable
-template <class In>
+CMB_EXPORT template <class In>
   concept indirectly_readable = 
     cmb::detail::indirectly_readable_impl<std::remove_cvref_t<In>>;
 
 
 // concept indirectly_writable
-template <class Out, class T>
+CMB_EXPORT template <class Out, class T>
   concept indirectly_writable =
     requires(Out&& o, T&& t) {
       *o = std::forward<T>(t);
@@ -29,7 +29,7 @@ template <class Out, class T>
 
 
 // concept weakly_incrementable
-template<class I>
+CMB_EXPORT template<class I>
   concept weakly_incrementable =
     cmb::default_initializable<I> and
     cmb::movable<I> and
@@ -42,7 +42,7 @@ template<class I>
 
 
 // concept incrementable
-template <class I>
+CMB_EXPORT template <class I>
   concept incrementable =
     cmb::regular<I> and
     cmb::weakly_incrementable<I> and
@@ -52,7 +52,7 @@ template <class I>
 
 
 // concept input_or_output_iterator
-template <class I>
+CMB_EXPORT template <class I>
   concept input_or_output_iterator =
     requires(I i) {
       { *i } -> cmb::detail::can_reference;
@@ -61,7 +61,7 @@ template <class I>
 
 
 // concept sentinel_for
-template <class S, class I>
+CMB_EXPORT template <class S, class I>
   concept sentinel_for =
     cmb::semiregular<S> and
     cmb::input_or_output_iterator<I> and
@@ -69,7 +69,7 @@ template <class S, class I>
 
 
 // concept sized_sentinel_for
-template <class S, class I>
+CMB_EXPORT template <class S, class I>
   concept sized_sentinel_for =
     cmb::sentinel_for<S, I> and
     not std::disable_sized_sentinel_for<
@@ -82,7 +82,7 @@ template <class S, class I>
 
 
 // concept input_iterator
-template <class I>
+CMB_EXPORT template <class I>
   concept input_iterator =
     cmb::input_or_output_iterator<I> and
     cmb::indirectly_readable<I> and
@@ -91,7 +91,7 @@ template <class I>
 
 
 // concept output_iterator
-template <class I, class T>
+CMB_EXPORT template <class I, class T>
   concept output_iterator =
     cmb::input_or_output_iterator<I> and
     cmb::indirectly_writable<I, T> and
@@ -101,7 +101,7 @@ template <class I, class T>
 
 
 // concept forward_iterator
-template <class I>
+CMB_EXPORT template <class I>
   concept forward_iterator =
     cmb::input_iterator<I> and
     cmb::derived_from<cmb::detail::iter_concept<I>, std::forward_iterator_tag> and
@@ -110,7 +110,7 @@ template <class I>
 
 
 // concept bidirectional_iterator
-template<class I>
+CMB_EXPORT template<class I>
   concept bidirectional_iterator =
     cmb::forward_iterator<I> and
     cmb::derived_from<cmb::detail::iter_concept<I>, std::bidirectional_iterator_tag> and
@@ -121,7 +121,7 @@ template<class I>
 
 
 // concept random_access_iterator
-template<class I>
+CMB_EXPORT template<class I>
   concept random_access_iterator =
     cmb::bidirectional_iterator<I> and
     cmb::derived_from<cmb::detail::iter_concept<I>, std::random_access_iterator_tag> and
@@ -138,14 +138,61 @@ template<class I>
 
 
 // concept contiguous_iterator
-template<class I>
+CMB_EXPORT template<class I>
   concept contiguous_iterator =
     cmb::random_access_iterator<I> and
     cmb::derived_from<cmb::detail::iter_concept<I>, std::contiguous_iterator_tag> and
     std::is_lvalue_reference_v<std::iter_reference_t<I>> and
     cmb::same_as<std::iter_value_t<I>, std::remove_cvref_t<std::iter_reference_t<I>>> and
     requires(const I& i) {
-      { to_address(i) } -> cmb::same_as<std::add_pointer_t<std::iter_reference_t<I>>>;
+      { std::to_address(i) } -> cmb::same_as<std::add_pointer_t<std::iter_reference_t<I>>>;
+    };
+
+
+//
+// Segmented iterators
+
+// class template segmented_iterator_traits
+// Iterators over chunked storage specialize segmented_iterator_traits to
+// expose the chunks as a range of segments, each of which is a range of
+// local iterators. For every iterator i in [begin, end], including end,
+// segment(i) must name a segment for which begin and end are valid, and
+// compose(segment(i), local(i)) == i.
+//
+//   using segment_iterator = ...;
+//   using local_iterator   = ...;
+//
+//   static segment_iterator segment(I);
+//   static local_iterator   local(I);
+//   static local_iterator   begin(segment_iterator);
+//   static local_iterator   end(segment_iterator);
+//   static I                compose(segment_iterator, local_iterator);
+CMB_EXPORT template <class I>
+  struct segmented_iterator_traits { };
+
+
+// concept segmented_iterator
+CMB_EXPORT template <class I>
+  concept segmented_iterator =
+    cmb::forward_iterator<I> and
+    requires {
+      typename cmb::segmented_iterator_traits<I>::segment_iterator;
+      typename cmb::segmented_iterator_traits<I>::local_iterator;
+    } and
+    cmb::forward_iterator<typename cmb::segmented_iterator_traits<I>::segment_iterator> and
+    cmb::forward_iterator<typename cmb::segmented_iterator_traits<I>::local_iterator> and
+    requires(I i,
+             typename cmb::segmented_iterator_traits<I>::segment_iterator s,
+             typename cmb::segmented_iterator_traits<I>::local_iterator l) {
+      { cmb::segmented_iterator_traits<I>::segment(i) } ->
+        cmb::same_as<typename cmb::segmented_iterator_traits<I>::segment_iterator>;
+      { cmb::segmented_iterator_traits<I>::local(i) } ->
+        cmb::same_as<typename cmb::segmented_iterator_traits<I>::local_iterator>;
+      { cmb::segmented_iterator_traits<I>::begin(s) } ->
+        cmb::same_as<typename cmb::segmented_iterator_traits<I>::local_iterator>;
+      { cmb::segmented_iterator_traits<I>::end(s) } ->
+        cmb::same_as<typename cmb::segmented_iterator_traits<I>::local_iterator>;
+      { cmb::segmented_iterator_traits<I>::compose(s, l) } -> cmb::same_as<I>;
     };
 
 
@@ -153,7 +200,7 @@ template<class I>
 // Indirect callable requirements
 
 // concept indirectly_unary_invocable
-template <class F, class I>
+CMB_EXPORT template <class F, class I>
   concept indirectly_unary_invocable =
     cmb::indirectly_readable<I> and
     cmb::copy_constructible<F> and
@@ -166,7 +213,7 @@ template <class F, class I>
 
 
 // concept indirectly_regular_unary_invocable
-template <class F, class I>
+CMB_EXPORT template <class F, class I>
   concept indirectly_regular_unary_invocable =
     cmb::indirectly_readable<I> and
     cmb::copy_constructible<F> and
@@ -179,7 +226,7 @@ template <class F, class I>
 
 
 // concept indirect_unary_predicate
-template <class F, class I>
+CMB_EXPORT template <class F, class I>
   concept indirect_unary_predicate =
     cmb::indirectly_readable<I> and
     cmb::copy_constructible<F> and
@@ -189,7 +236,7 @@ template <class F, class I>
 
 
 // concept indirect_binary_predicate
-template <class F, class I1, class I2>
+CMB_EXPORT template <class F, class I1, class I2>
   concept indirect_binary_predicate =
     cmb::indirectly_readable<I1> and
     cmb::indirectly_readable<I2> and
@@ -202,7 +249,7 @@ template <class F, class I1, class I2>
 
 
 // concept indirect_equivalence_relation
-template <class F, class I1, class I2 = I1>
+CMB_EXPORT template <class F, class I1, class I2 = I1>
   concept indirect_equivalence_relation =
     cmb::indirectly_readable<I1> and
     cmb::indirectly_readable<I2> and
@@ -215,7 +262,7 @@ template <class F, class I1, class I2 = I1>
 
 
 // concept indirect_strict_weak_order
-template<class F, class I1, class I2 = I1>
+CMB_EXPORT template<class F, class I1, class I2 = I1>
   concept indirect_strict_weak_order =
     cmb::indirectly_readable<I1> and
     cmb::indirectly_readable<I2> and
@@ -231,14 +278,14 @@ template<class F, class I1, class I2 = I1>
 // Common algorithm requirements
 
 // concept indirectly_movable
-template <class In, class Out>
+CMB_EXPORT template <class In, class Out>
   concept indirectly_movable =
     cmb::indirectly_readable<In> and
     cmb::indirectly_writable<Out, std::iter_rvalue_reference_t<In>>;
 
 
 // concept indirectly_movable_storable
-template <class In, class Out>
+CMB_EXPORT template <class In, class Out>
   concept indirectly_movable_storable =
     cmb::indirectly_movable<In, Out> and
     cmb::indirectly_writable<Out, std::iter_value_t<In>> and
@@ -252,14 +299,14 @@ template <class In, class Out>
 
 
 // concept indirectly_copyable
-template <class In, class Out>
+CMB_EXPORT template <class In, class Out>
   concept indirectly_copyable =
     cmb::indirectly_readable<In> and
     cmb::indirectly_writable<Out, std::iter_reference_t<In>>;
 
 
 // concept indirectly_copyable_storable
-template <class In, class Out>
+CMB_EXPORT template <class In, class Out>
   concept indirectly_copyable_storable =
     cmb::indirectly_copyable<In, Out> and
     cmb::indirectly_writable<Out, std::iter_value_t<In>&> and
@@ -276,7 +323,7 @@ template <class In, class Out>
 
 
 // concept indirectly_swappable
-template <class I1, class I2 = I1>
+CMB_EXPORT template <class I1, class I2 = I1>
   concept indirectly_swappable =
     cmb::indirectly_readable<I1> and
     cmb::indirectly_readable<I2> and
@@ -289,14 +336,14 @@ template <class I1, class I2 = I1>
 
 
 // concept indirectly_comparable
-template <class I1, class I2, class R, class P1 = std::identity,
+CMB_EXPORT template <class I1, class I2, class R, class P1 = std::identity,
           class P2 = std::identity>
   concept indirectly_comparable =
     cmb::indirect_binary_predicate<R, std::projected<I1, P1>, std::projected<I2, P2>>;
 
 
 // concept permutable
-template <class I>
+CMB_EXPORT template <class I>
   concept permutable =
     cmb::forward_iterator<I> and
     cmb::indirectly_movable_storable<I, I> and
@@ -304,7 +351,7 @@ template <class I>
 
 
 // concept mergeable
-template <class I1, class I2, class Out, class R = std::ranges::less,
+CMB_EXPORT template <class I1, class I2, class Out, class R = std::ranges::less,
           class P1 = std::identity, class P2 = std::identity>
   concept mergeable =
     cmb::input_iterator<I1> and
@@ -316,7 +363,7 @@ template <class I1, class I2, class Out, class R = std::ranges::less,
 
 
 // concept sortable
-template <class I, class R = std::ranges::less, class P = std::identity>
+CMB_EXPORT template <class I, class R = std::ranges::less, class P = std::identity>
   concept sortable =
     cmb::permutable<I> and
     cmb::indirect_strict_weak_order<R, std::projected<I, P>>;
@@ -21,24 +21,55 @@ template <class T>
 //
 // alias template ITER_CONCEPT(I)
 
-// For a type I, let ITER_­TRAITS(I) denote the type I if iterator_­traits<I>
+// For a type I, let ITER_TRAITS(I) denote the type I if iterator_traits<I>
 // names a specialization generated from the primary template. Otherwise,
-// ITER_­TRAITS(I) denotes iterator_­traits<I>.
+// ITER_TRAITS(I) denotes iterator_traits<I>.
+template <class I>
+  struct iter_traits_impl {
+    using type = std::iterator_traits<I>;
+  };
+
+template <class I>
+  requires std::__detail::__primary_traits_iter<I> // defined within libstdc++-v3
+  struct iter_traits_impl<I> {
+    using type = I;
+  };
+
+// ITER_TRAITS
+template <class I>
+  using iter_traits = typename cmb::detail::iter_traits_impl<I>::type;
+
 template <class I>
   struct iter_concept_impl;
 
-// If the qualified-id ITER_­TRAITS(I)​::​iterator_­concept is valid and names a
-// type, then ITER_­CONCEPT(I) denotes that type.
+// If the qualified-id ITER_TRAITS(I)::iterator_concept is valid and names a
+// type, then ITER_CONCEPT(I) denotes that type.
 template <class I>
-  requires ( requires { typename std::iterator_traits<I>::iterator_concept; } )
+  requires ( requires { typename cmb::detail::iter_traits<I>::iterator_concept; } )
   struct iter_concept_impl<I> {
-    using type = typename std::iterator_traits<I>::iterator_concept;
+    using type = typename cmb::detail::iter_traits<I>::iterator_concept;
   };
 
-// Omitting additional implementation requirements of ITER_CONCEPT(I) 
-// for the sake of simplicity
+// Otherwise, if the qualified-id ITER_TRAITS(I)::iterator_category is valid
+// and names a type, then ITER_CONCEPT(I) denotes that type.
+template <class I>
+  requires ( not requires { typename cmb::detail::iter_traits<I>::iterator_concept; } and
+                 requires { typename cmb::detail::iter_traits<I>::iterator_category; } )
+  struct iter_concept_impl<I> {
+    using type = typename cmb::detail::iter_traits<I>::iterator_category;
+  };
+
+// Otherwise, if iterator_traits<I> names a specialization generated from the
+// primary template, then ITER_CONCEPT(I) denotes random_access_iterator_tag.
+template <class I>
+  requires ( not requires { typename cmb::detail::iter_traits<I>::iterator_concept; } and
+             not requires { typename cmb::detail::iter_traits<I>::iterator_category; } and
+             std::__detail::__primary_traits_iter<I> )
+  struct iter_concept_impl<I> {
+    using type = std::random_access_iterator_tag;
+  };
 
-// Otherwise, ITER_­CONCEPT(I) does not denote a type.
+// Otherwise, ITER_CONCEPT(I) does not denote a type.
 template <class I>
   struct iter_concept_impl { };
 
@@ -0,0 +1,159 @@
+#ifndef MAPPED_FILE_HXX
+#define MAPPED_FILE_HXX
+
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <ranges.hxx>
+
+
+namespace cmb {
+
+//
+// Memory-mapped files (POSIX)
+
+// enum access_hint
+// How the mapping is going to be read; passed on to madvise.
+CMB_EXPORT enum class access_hint { normal, sequential, random };
+
+
+// class file_mapping
+// Maps a whole file read-only into memory and unmaps it when destroyed.
+// Failures to open, stat or map the file throw std::system_error.
+
+CMB_EXPORT class file_mapping {
+public:
+  file_mapping() noexcept = default;
+
+  explicit file_mapping(char const* path, cmb::access_hint hint = cmb::access_hint::normal)
+  {
+    int const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), path);
+
+    auto fail = [fd, path] {
+      int const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path);
+    };
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+      fail();
+
+    // mmap rejects empty mappings, so an empty file maps to no storage
+    if (st.st_size > 0) {
+      void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED)
+        fail();
+      data_ = static_cast<std::byte const*>(p);
+      size_ = static_cast<std::size_t>(st.st_size);
+      advise(hint);
+    }
+    ::close(fd);
+  }
+
+  explicit file_mapping(std::string const& path, cmb::access_hint hint = cmb::access_hint::normal)
+    : file_mapping(path.c_str(), hint)
+  { }
+
+  file_mapping(file_mapping&& other) noexcept
+    : data_{ std::exchange(other.data_, nullptr) },
+      size_{ std::exchange(other.size_, 0) }
+  { }
+
+  file_mapping& operator=(file_mapping&& other) noexcept
+  {
+    file_mapping moved(std::move(other));
+    std::swap(data_, moved.data_);
+    std::swap(size_, moved.size_);
+    return *this;
+  }
+
+  ~file_mapping()
+  {
+    if (data_ != nullptr)
+      ::munmap(const_cast<std::byte*>(data_), size_);
+  }
+
+  std::byte const* data() const noexcept { return data_; }
+  std::size_t      size() const noexcept { return size_; }
+
+  // The hint is advisory; a kernel that ignores it leaves the mapping usable.
+  void advise(cmb::access_hint hint) const noexcept
+  {
+    int const advice = hint == cmb::access_hint::sequential ? MADV_SEQUENTIAL
+                     : hint == cmb::access_hint::random     ? MADV_RANDOM
+                     :                                        MADV_NORMAL;
+    if (data_ != nullptr)
+      ::madvise(const_cast<std::byte*>(data_), size_, advice);
+  }
+
+private:
+  std::byte const* data_ = nullptr;
+  std::size_t      size_ = 0;
+};
+
+
+// class template mapped_file
+// A view of the records of type T stored back to back in a file_mapping.
+// Like std::string_view, it does not own the mapping: its iterators stay
+// valid for as long as the file_mapping is alive, which makes it a
+// borrowed_range, and they are plain pointers into the mapped pages, which
+// makes it a contiguous_range. It cannot be constructed from a temporary
+// file_mapping. A file whose size is not a whole number of records throws
+// std::length_error.
+
+CMB_EXPORT template <class T>
+  requires std::is_object_v<T> and std::is_trivially_copyable_v<T>
+  class mapped_file : public std::ranges::view_interface<cmb::mapped_file<T>> {
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T const&;
+    using const_reference = T const&;
+    using pointer         = T const*;
+    using const_pointer   = T const*;
+    using iterator        = T const*;
+    using const_iterator  = T const*;
+
+    mapped_file() noexcept = default;
+
+    explicit mapped_file(cmb::file_mapping const& mapping)
+      : data_{ reinterpret_cast<T const*>(mapping.data()) },
+        size_{ mapping.size() / sizeof(T) }
+    {
+      static_assert(alignof(T) <= 4096, "mappings are only page aligned");
+      if (mapping.size() % sizeof(T) != 0)
+        throw std::length_error("cmb::mapped_file: file size is not a multiple of the record size");
+    }
+
+    // A temporary mapping would be unmapped before the view is used.
+    mapped_file(cmb::file_mapping&&) = delete;
+
+    iterator  begin() const noexcept { return data_; }
+    iterator  end()   const noexcept { return data_ + size_; }
+    pointer   data()  const noexcept { return data_; }
+    size_type size()  const noexcept { return size_; }
+
+  private:
+    T const*  data_ = nullptr;
+    size_type size_ = 0;
+  };
+
+} // namespace cmb
+
+
+template <class T>
+  inline constexpr bool std::ranges::enable_borrowed_range<cmb::mapped_file<T>> = true;
+
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef NUMERIC_HXX
+#define NUMERIC_HXX
+
+#include <algorithm.hxx>
+
+
+namespace cmb {
+
+//
+// Reduction algorithms
+// Contiguous ranges of integral values, and of floating-point values with
+// fp_order::reassociate, are summed with vectorized kernels selected at run
+// time; other ranges are summed in order by a scalar loop.
+
+// function sum
+CMB_EXPORT template <class I, class S>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::default_initializable<std::iter_value_t<I>> and
+           cmb::assignable_from<std::iter_value_t<I>&,
+             decltype(std::declval<std::iter_value_t<I>>() + *std::declval<I&>())>
+  constexpr std::iter_value_t<I> sum(I first, S last, cmb::fp_order = cmb::fp_order::strict)
+  {
+    std::iter_value_t<I> r{ };
+    for (; first != last; ++first)
+      r = r + *first;
+    return r;
+  }
+
+CMB_EXPORT template <class I, class S>
+  requires cmb::input_iterator<I> and
+           cmb::sentinel_for<S, I> and
+           cmb::default_initializable<std::iter_value_t<I>> and
+           cmb::assignable_from<std::iter_value_t<I>&,
+             decltype(std::declval<std::iter_value_t<I>>() + *std::declval<I&>())> and
+           cmb::detail::simd_range<I, S>
+  constexpr std::iter_value_t<I> sum(I first, S last, cmb::fp_order order = cmb::fp_order::strict)
+  {
+    if (std::is_constant_evaluated() or
+        ( cmb::floating_point<std::iter_value_t<I>> and order == cmb::fp_order::strict )) {
+      std::iter_value_t<I> r{ };
+      for (; first != last; ++first)
+        r = r + *first;
+      return r;
+    }
+    auto const n = static_cast<std::size_t>(last - first);
+    return cmb::detail::dispatch<cmb::detail::sum_kernel>(std::to_address(first), n);
+  }
+
+} // namespace cmb
+
+
+#endif
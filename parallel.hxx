@@ -0,0 +1,303 @@
+#ifndef PARALLEL_HXX
+#define PARALLEL_HXX
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <algorithm.hxx>
+#include <thread_pool.hxx>
+
+
+namespace cmb    {
+namespace detail {
+
+//
+// helper function grain_size
+
+// Number of elements handled by one task: enough tasks to keep every thread
+// of the pool busy while stealing evens out the load, but never so few
+// elements that scheduling a task costs more than running it.
+template <class D>
+  D grain_size(D n, std::size_t concurrency)
+  {
+    D const min_grain = 4096;
+    D const tasks     = static_cast<D>(concurrency * 8);
+    return std::max(min_grain, n / tasks + 1);
+  }
+
+
+//
+// helper function for_each_chunk
+
+// Calls body(begin, end) for consecutive chunks of [0, n) of at most grain
+// elements, each on its own task.
+template <class D, class F>
+  void for_each_chunk(cmb::parallel::thread_pool& pool, D n, D grain, F body)
+  {
+    cmb::parallel::task_group group(pool);
+    for (D begin = 0; begin < n; begin += grain) {
+      D const end = std::min(n, begin + grain);
+      group.run([&body, begin, end] { body(begin, end); });
+    }
+    group.wait();
+  }
+
+
+//
+// helper function merge_split
+
+// Number of elements of [a, a + n1) among the first k elements of the
+// stable merge of [a, a + n1) and [b, b + n2).
+template <class I1, class D1, class I2, class D2, class D, class R, class P1, class P2>
+  D1 merge_split(I1 a, D1 n1, I2 b, D2 n2, D k, R& comp, P1& proj1, P2& proj2)
+  {
+    D1 lo = static_cast<D1>(std::max<D>(0, k - static_cast<D>(n2)));
+    D1 hi = static_cast<D1>(std::min<D>(k, static_cast<D>(n1)));
+    while (lo < hi) {
+      D1 const i = lo + (hi - lo) / 2;
+      D2 const j = static_cast<D2>(k - static_cast<D>(i));
+      // a[i] precedes b[j - 1] in the merge unless b[j - 1] < a[i]
+      if (not std::invoke(comp, std::invoke(proj2, b[j - 1]), std::invoke(proj1, a[i])))
+        lo = i + 1;
+      else
+        hi = i;
+    }
+    return lo;
+  }
+
+
+//
+// helper function merge_chunks
+
+// Adds tasks to group that merge [a, a + n1) and [b, b + n2) into out, each
+// task producing at most grain elements of the output. The split points are
+// found before any task starts, since the tasks may move from the input.
+template <class I1, class D1, class I2, class D2, class O, class D, class R, class P1, class P2>
+  void merge_chunks(cmb::parallel::task_group& group,
+                    I1 a, D1 n1, I2 b, D2 n2, O out, D grain,
+                    R& comp, P1& proj1, P2& proj2)
+  {
+    D const n = static_cast<D>(n1) + static_cast<D>(n2);
+    std::vector<D1> split(1, 0);
+    for (D k = grain; k < n; k += grain)
+      split.push_back(cmb::detail::merge_split(a, n1, b, n2, k, comp, proj1, proj2));
+    split.push_back(n1);
+
+    for (std::size_t c = 0; c + 1 < split.size(); ++c) {
+      D  const k    = static_cast<D>(c) * grain;
+      D  const kend = std::min(n, k + grain);
+      D1 const i    = split[c];
+      D1 const iend = split[c + 1];
+      D2 const j    = static_cast<D2>(k - static_cast<D>(i));
+      D2 const jend = static_cast<D2>(kend - static_cast<D>(iend));
+      group.run([=, &comp, &proj1, &proj2] {
+        std::ranges::merge(a + i, a + iend, b + j, b + jend, out + k, comp, proj1, proj2);
+      });
+    }
+  }
+
+} // namespace detail
+
+
+namespace parallel {
+
+//
+// Parallel algorithms
+// Each algorithm splits its range into tasks of grain_size elements, chosen
+// from the length of the range and the concurrency of the pool, and runs
+// them on the given thread_pool or on default_pool().
+
+// function for_each
+CMB_EXPORT template <class I, class S, class F>
+  requires cmb::random_access_iterator<I> and
+           cmb::sized_sentinel_for<S, I> and
+           cmb::indirectly_regular_unary_invocable<F, I>
+  I for_each(cmb::parallel::thread_pool& pool, I first, S last, F f)
+  {
+    auto const n     = last - first;
+    auto const grain = cmb::detail::grain_size(n, pool.concurrency());
+    cmb::detail::for_each_chunk(pool, n, grain, [&](auto begin, auto end) {
+      for (I i = first + begin, e = first + end; i != e; ++i)
+        std::invoke(f, *i);
+    });
+    return first + n;
+  }
+
+CMB_EXPORT template <class I, class S, class F>
+  requires cmb::random_access_iterator<I> and
+           cmb::sized_sentinel_for<S, I> and
+           cmb::indirectly_regular_unary_invocable<F, I>
+  I for_each(I first, S last, F f)
+  {
+    return cmb::parallel::for_each(cmb::parallel::default_pool(),
+                                   std::move(first), std::move(last), std::move(f));
+  }
+
+
+// function transform_reduce
+// reduce must be associative and commutative; the partial results of the
+// tasks are combined with init in an unspecified grouping.
+CMB_EXPORT template <class I, class S, class T, class R, class F>
+  requires cmb::random_access_iterator<I> and
+           cmb::sized_sentinel_for<S, I> and
+           cmb::indirectly_regular_unary_invocable<F, I> and
+           cmb::movable<T> and
+           cmb::constructible_from<T, std::indirect_result_t<F&, I>> and
+           cmb::copy_constructible<R> and
+           cmb::regular_invocable<R&, T, T> and
+           cmb::assignable_from<T&, std::invoke_result_t<R&, T, T>>
+  T transform_reduce(cmb::parallel::thread_pool& pool, I first, S last, T init, R reduce, F transform)
+  {
+    auto const n      = last - first;
+    auto const grain  = cmb::detail::grain_size(n, pool.concurrency());
+    auto const chunks = static_cast<std::size_t>((n + grain - 1) / grain);
+
+    std::vector<std::optional<T>> partial(chunks);
+    cmb::detail::for_each_chunk(pool, n, grain, [&](auto begin, auto end) {
+      I i = first + begin;
+      I const e = first + end;
+      T acc(std::invoke(transform, *i));
+      for (++i; i != e; ++i)
+        acc = std::invoke(reduce, std::move(acc), T(std::invoke(transform, *i)));
+      partial[static_cast<std::size_t>(begin / grain)].emplace(std::move(acc));
+    });
+
+    for (auto& p : partial)
+      init = std::invoke(reduce, std::move(init), std::move(*p));
+    return init;
+  }
+
+CMB_EXPORT template <class I, class S, class T, class R, class F>
+  requires cmb::random_access_iterator<I> and
+           cmb::sized_sentinel_for<S, I> and
+           cmb::indirectly_regular_unary_invocable<F, I> and
+           cmb::movable<T> and
+           cmb::constructible_from<T, std::indirect_result_t<F&, I>> and
+           cmb::copy_constructible<R> and
+           cmb::regular_invocable<R&, T, T> and
+           cmb::assignable_from<T&, std::invoke_result_t<R&, T, T>>
+  T transform_reduce(I first, S last, T init, R reduce, F transform)
+  {
+    return cmb::parallel::transform_reduce(cmb::parallel::default_pool(),
+                                           std::move(first), std::move(last), std::move(init),
+                                           std::move(reduce), std::move(transform));
+  }
+
+
+// function merge
+CMB_EXPORT template <class I1, class S1, class I2, class S2, class O,
+                     class R = std::ranges::less, class P1 = std::identity, class P2 = std::identity>
+  requires cmb::random_access_iterator<I1> and
+           cmb::sized_sentinel_for<S1, I1> and
+           cmb::random_access_iterator<I2> and
+           cmb::sized_sentinel_for<S2, I2> and
+           cmb::random_access_iterator<O> and
+           cmb::mergeable<I1, I2, O, R, P1, P2>
+  O merge(cmb::parallel::thread_pool& pool, I1 first1, S1 last1, I2 first2, S2 last2, O result,
+          R comp = { }, P1 proj1 = { }, P2 proj2 = { })
+  {
+    auto const n1    = last1 - first1;
+    auto const n2    = last2 - first2;
+    auto const n     = static_cast<std::iter_difference_t<O>>(n1 + n2);
+    auto const grain = cmb::detail::grain_size(n, pool.concurrency());
+
+    cmb::parallel::task_group group(pool);
+    cmb::detail::merge_chunks(group, first1, n1, first2, n2, result, grain, comp, proj1, proj2);
+    group.wait();
+    return result + n;
+  }
+
+CMB_EXPORT template <class I1, class S1, class I2, class S2, class O,
+                     class R = std::ranges::less, class P1 = std::identity, class P2 = std::identity>
+  requires cmb::random_access_iterator<I1> and
+           cmb::sized_sentinel_for<S1, I1> and
+           cmb::random_access_iterator<I2> and
+           cmb::sized_sentinel_for<S2, I2> and
+           cmb::random_access_iterator<O> and
+           cmb::mergeable<I1, I2, O, R, P1, P2>
+  O merge(I1 first1, S1 last1, I2 first2, S2 last2, O result,
+          R comp = { }, P1 proj1 = { }, P2 proj2 = { })
+  {
+    return cmb::parallel::merge(cmb::parallel::default_pool(),
+                                std::move(first1), std::move(last1),
+                                std::move(first2), std::move(last2), std::move(result),
+                                std::move(comp), std::move(proj1), std::move(proj2));
+  }
+
+
+// function sort
+// Sorts runs of grain_size elements in parallel, then merges pairs of runs
+// level by level, alternating between the range and a buffer. Every merge
+// is itself split into tasks, so the last levels stay parallel too.
+CMB_EXPORT template <class I, class S, class R = std::ranges::less, class P = std::identity>
+  requires cmb::random_access_iterator<I> and
+           cmb::sized_sentinel_for<S, I> and
+           cmb::sortable<I, R, P>
+  I sort(cmb::parallel::thread_pool& pool, I first, S last, R comp = { }, P proj = { })
+  {
+    using D = std::iter_difference_t<I>;
+    using V = std::iter_value_t<I>;
+
+    D const n     = last - first;
+    I const end   = first + n;
+    D const grain = cmb::detail::grain_size(n, pool.concurrency());
+    if (n <= grain or pool.concurrency() == 1) {
+      std::ranges::sort(first, end, comp, proj);
+      return end;
+    }
+
+    cmb::detail::for_each_chunk(pool, n, grain, [&](D lo, D hi) {
+      std::ranges::sort(first + lo, first + hi, comp, proj);
+    });
+
+    // The sorted runs are moved into the buffer, which leaves the range
+    // moved-from, so the first level merges from the buffer into the range.
+    std::vector<V> buffer(std::make_move_iterator(first), std::make_move_iterator(end));
+
+    auto merge_level = [&](auto src, auto dst, D width) {
+      cmb::parallel::task_group group(pool);
+      for (D lo = 0; lo < n; lo += 2 * width) {
+        D const mid = std::min(n, lo + width);
+        D const hi  = std::min(n, lo + 2 * width);
+        cmb::detail::merge_chunks(group,
+                                  std::make_move_iterator(src + lo), mid - lo,
+                                  std::make_move_iterator(src + mid), hi - mid,
+                                  dst + lo, grain, comp, proj, proj);
+      }
+      group.wait();
+    };
+
+    bool in_buffer = true;
+    for (D width = grain; width < n; width *= 2) {
+      if (in_buffer)
+        merge_level(buffer.begin(), first, width);
+      else
+        merge_level(first, buffer.begin(), width);
+      in_buffer = not in_buffer;
+    }
+
+    if (in_buffer) {
+      cmb::detail::for_each_chunk(pool, n, grain, [&](D lo, D hi) {
+        std::ranges::move(buffer.begin() + lo, buffer.begin() + hi, first + lo);
+      });
+    }
+    return end;
+  }
+
+CMB_EXPORT template <class I, class S, class R = std::ranges::less, class P = std::identity>
+  requires cmb::random_access_iterator<I> and
+           cmb::sized_sentinel_for<S, I> and
+           cmb::sortable<I, R, P>
+  I sort(I first, S last, R comp = { }, P proj = { })
+  {
+    return cmb::parallel::sort(cmb::parallel::default_pool(),
+                               std::move(first), std::move(last),
+                               std::move(comp), std::move(proj));
+  }
+
+} // namespace parallel
+} // namespace cmb
+
+
+#endif
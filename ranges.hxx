@@ -0,0 +1,110 @@
+#ifndef RANGES_HXX
+#define RANGES_HXX
+
+#include <ranges>
+#include <iterator.hxx>
+
+
+namespace cmb {
+
+//
+// Range concepts
+// The concepts are stated in terms of the cmb iterator concepts; begin, end,
+// size and data are the std::ranges customization points, and the opt-ins
+// enable_borrowed_range and enable_view are the standard ones, so ranges
+// that opt in for std::ranges model the cmb concepts as well.
+
+// concept range
+CMB_EXPORT template <class R>
+  concept range =
+    requires(R& r) {
+      std::ranges::begin(r);
+      std::ranges::end(r);
+    } and
+    cmb::input_or_output_iterator<std::ranges::iterator_t<R>> and
+    cmb::sentinel_for<std::ranges::sentinel_t<R>, std::ranges::iterator_t<R>>;
+
+
+// concept borrowed_range
+// Iterators obtained from a borrowed range do not dangle when the range
+// object itself is destroyed.
+CMB_EXPORT template <class R>
+  concept borrowed_range =
+    cmb::range<R> and
+    ( std::is_lvalue_reference_v<R> or
+      std::ranges::enable_borrowed_range<std::remove_cvref_t<R>> );
+
+
+// concept sized_range
+CMB_EXPORT template <class R>
+  concept sized_range =
+    cmb::range<R> and
+    requires(R& r) {
+      std::ranges::size(r);
+    };
+
+
+// concept view
+CMB_EXPORT template <class T>
+  concept view =
+    cmb::range<T> and
+    cmb::movable<T> and
+    std::ranges::enable_view<T>;
+
+
+// concept output_range
+CMB_EXPORT template <class R, class T>
+  concept output_range =
+    cmb::range<R> and
+    cmb::output_iterator<std::ranges::iterator_t<R>, T>;
+
+
+// concept input_range
+CMB_EXPORT template <class R>
+  concept input_range =
+    cmb::range<R> and
+    cmb::input_iterator<std::ranges::iterator_t<R>>;
+
+
+// concept forward_range
+CMB_EXPORT template <class R>
+  concept forward_range =
+    cmb::input_range<R> and
+    cmb::forward_iterator<std::ranges::iterator_t<R>>;
+
+
+// concept bidirectional_range
+CMB_EXPORT template <class R>
+  concept bidirectional_range =
+    cmb::forward_range<R> and
+    cmb::bidirectional_iterator<std::ranges::iterator_t<R>>;
+
+
+// concept random_access_range
+CMB_EXPORT template <class R>
+  concept random_access_range =
+    cmb::bidirectional_range<R> and
+    cmb::random_access_iterator<std::ranges::iterator_t<R>>;
+
+
+// concept contiguous_range
+CMB_EXPORT template <class R>
+  concept contiguous_range =
+    cmb::random_access_range<R> and
+    cmb::contiguous_iterator<std::ranges::iterator_t<R>> and
+    requires(R& r) {
+      { std::ranges::data(r) } ->
+        cmb::same_as<std::add_pointer_t<std::ranges::range_reference_t<R>>>;
+    };
+
+
+// concept common_range
+CMB_EXPORT template <class R>
+  concept common_range =
+    cmb::range<R> and
+    cmb::same_as<std::ranges::iterator_t<R>, std::ranges::sentinel_t<R>>;
+
+} // namespace cmb
+
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef SIMD_IMPL_HXX
+#define SIMD_IMPL_HXX
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <iterator.hxx>
+
+// The helpers below pass vectors by value, but they are always inlined into
+// the dispatch wrappers, so no vector ever crosses a call boundary.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+
+namespace cmb    {
+namespace detail {
+
+//
+// helper concept simd_element
+
+// Arithmetic types that GCC vector extensions can hold.
+template <class T>
+  concept simd_element =
+    ( cmb::integral<T> and not cmb::same_as<T, bool> and sizeof(T) <= 8 ) or
+    cmb::same_as<T, float> or
+    cmb::same_as<T, double>;
+
+
+//
+// helper concept non_volatile_iterator
+
+// The elements of I can be accessed as plain memory; volatile elements must
+// be read and written one at a time.
+template <class I>
+  concept non_volatile_iterator =
+    not std::is_volatile_v<std::remove_reference_t<std::iter_reference_t<I>>>;
+
+
+//
+// helper concept simd_range
+
+// [first, last) can be handed to the kernels as a pointer and a length.
+template <class I, class S>
+  concept simd_range =
+    cmb::contiguous_iterator<I> and
+    cmb::detail::non_volatile_iterator<I> and
+    cmb::sized_sentinel_for<S, I> and
+    cmb::detail::simd_element<std::iter_value_t<I>>;
+
+
+//
+// alias template simd_vector
+
+template <std::size_t Bytes, class T>
+  struct simd_vector_impl {
+    typedef T type __attribute__((vector_size(Bytes)));
+  };
+
+template <std::size_t Bytes, class T>
+  using simd_vector = typename cmb::detail::simd_vector_impl<Bytes, T>::type;
+
+
+//
+// helper functions load, broadcast and any
+
+template <std::size_t Bytes, class T>
+  [[gnu::always_inline]] inline simd_vector<Bytes, T> load(T const* p)
+  {
+    simd_vector<Bytes, T> v;
+    std::memcpy(&v, p, Bytes);
+    return v;
+  }
+
+template <std::size_t Bytes, class T>
+  [[gnu::always_inline]] inline simd_vector<Bytes, T> broadcast(T x)
+  {
+    simd_vector<Bytes, T> v;
+    for (std::size_t i = 0; i < Bytes / sizeof(T); ++i)
+      v[i] = x;
+    return v;
+  }
+
+// true if any lane of the comparison mask m is set
+template <class M>
+  [[gnu::always_inline]] inline bool any(M const& m)
+  {
+    unsigned long long words[sizeof(M) / 8];
+    std::memcpy(words, &m, sizeof(M));
+    unsigned long long r = 0;
+    for (auto w : words)
+      r |= w;
+    return r != 0;
+  }
+
+
+//
+// Kernels
+// Each kernel processes Bytes-wide vectors followed by a scalar tail. They
+// are always inlined into the dispatch wrappers below, which compile them
+// for the instruction set selected at run time. A kernel may declare
+// max_bytes to cap the vector width used on AVX-512.
+
+// kernel sum
+// Integral values are summed in unsigned lanes, which wrap the same way the
+// scalar loop's conversions back to T do.
+struct sum_kernel {
+  template <std::size_t Bytes, class T>
+    [[gnu::always_inline]] static T run(T const* p, std::size_t n)
+    {
+      using U = typename std::conditional_t<cmb::integral<T>,
+                                            std::make_unsigned<T>,
+                                            std::type_identity<T>>::type;
+      return static_cast<T>(run_as<Bytes, U>(p, n));
+    }
+
+  template <std::size_t Bytes, class U, class T>
+    [[gnu::always_inline]] static U run_as(T const* p, std::size_t n)
+    {
+      using V = simd_vector<Bytes, U>;
+      constexpr std::size_t L = Bytes / sizeof(U);
+
+      U const* q = reinterpret_cast<U const*>(p);
+
+      V a0 = { }, a1 = { }, a2 = { }, a3 = { };
+      std::size_t i = 0;
+      for (; i + 4 * L <= n; i += 4 * L) {
+        a0 += load<Bytes>(q + i);
+        a1 += load<Bytes>(q + i + L);
+        a2 += load<Bytes>(q + i + 2 * L);
+        a3 += load<Bytes>(q + i + 3 * L);
+      }
+      for (; i + L <= n; i += L)
+        a0 += load<Bytes>(q + i);
+
+      V const a = (a0 + a1) + (a2 + a3);
+      U r = U{ };
+      for (std::size_t k = 0; k < L; ++k)
+        r += a[k];
+      for (; i < n; ++i)
+        r += q[i];
+      return r;
+    }
+};
+
+
+// kernel min
+struct min_kernel {
+  template <std::size_t Bytes, class T>
+    [[gnu::always_inline]] static T run(T const* p, std::size_t n)
+    {
+      using V = simd_vector<Bytes, T>;
+      constexpr std::size_t L = Bytes / sizeof(T);
+
+      T r = p[0];
+      std::size_t i = 0;
+      if (n >= L) {
+        V m = load<Bytes>(p);
+        for (i = L; i + L <= n; i += L) {
+          V const v = load<Bytes>(p + i);
+          m = v < m ? v : m;
+        }
+        for (std::size_t k = 0; k < L; ++k)
+          r = m[k] < r ? m[k] : r;
+      }
+      for (; i < n; ++i)
+        r = p[i] < r ? p[i] : r;
+      return r;
+    }
+};
+
+
+// kernel max
+struct max_kernel {
+  template <std::size_t Bytes, class T>
+    [[gnu::always_inline]] static T run(T const* p, std::size_t n)
+    {
+      using V = simd_vector<Bytes, T>;
+      constexpr std::size_t L = Bytes / sizeof(T);
+
+      T r = p[0];
+      std::size_t i = 0;
+      if (n >= L) {
+        V m = load<Bytes>(p);
+        for (i = L; i + L <= n; i += L) {
+          V const v = load<Bytes>(p + i);
+          m = m < v ? v : m;
+        }
+        for (std::size_t k = 0; k < L; ++k)
+          r = r < m[k] ? m[k] : r;
+      }
+      for (; i < n; ++i)
+        r = r < p[i] ? p[i] : r;
+      return r;
+    }
+};
+
+
+// kernel find
+// Returns the index of the first element equal to x, or n. GCC lowers the
+// early exit on 64-byte comparison masks through the stack, so the AVX-512
+// path runs this kernel on 32-byte vectors.
+struct find_kernel {
+  static constexpr std::size_t max_bytes = 32;
+
+  template <std::size_t Bytes, class T>
+    [[gnu::always_inline]] static std::size_t run(T const* p, std::size_t n, T x)
+    {
+      constexpr std::size_t L = Bytes / sizeof(T);
+
+      auto const v = broadcast<Bytes>(x);
+      std::size_t i = 0;
+      for (; i + 4 * L <= n; i += 4 * L) {
+        auto const m = (load<Bytes>(p + i)         == v) |
+                       (load<Bytes>(p + i + L)     == v) |
+                       (load<Bytes>(p + i + 2 * L) == v) |
+                       (load<Bytes>(p + i + 3 * L) == v);
+        if (any(m))
+          break;
+      }
+      for (; i < n; ++i)
+        if (p[i] == x)
+          return i;
+      return n;
+    }
+};
+
+
+// kernel count
+struct count_kernel {
+  template <std::size_t Bytes, class T>
+    [[gnu::always_inline]] static std::size_t run(T const* p, std::size_t n, T x)
+    {
+      constexpr std::size_t L = Bytes / sizeof(T);
+
+      // lanes of the comparison mask are as wide as T, so flush the
+      // per-lane counters before they can overflow
+      constexpr std::size_t flush = sizeof(T) == 1 ? 127
+                                  : sizeof(T) == 2 ? 32767
+                                  : std::size_t(1) << 30;
+
+      auto const v = broadcast<Bytes>(x);
+      std::size_t r = 0;
+      std::size_t i = 0;
+      while (i + L <= n) {
+        decltype(v == v) c = { };
+        for (std::size_t k = 0; k < flush and i + L <= n; ++k, i += L)
+          c -= (load<Bytes>(p + i) == v);
+        for (std::size_t k = 0; k < L; ++k)
+          r += static_cast<std::size_t>(c[k]);
+      }
+      for (; i < n; ++i)
+        r += p[i] == x;
+      return r;
+    }
+};
+
+
+//
+// Run-time dispatch
+
+enum class simd_level { generic, sse2, avx2, avx512 };
+
+inline cmb::detail::simd_level detect_simd_level() noexcept
+{
+#if defined(__GNUC__) and ( defined(__x86_64__) or defined(__i386__) )
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw"))
+    return cmb::detail::simd_level::avx512;
+  if (__builtin_cpu_supports("avx2"))
+    return cmb::detail::simd_level::avx2;
+  if (__builtin_cpu_supports("sse2"))
+    return cmb::detail::simd_level::sse2;
+#endif
+  return cmb::detail::simd_level::generic;
+}
+
+inline cmb::detail::simd_level current_simd_level() noexcept
+{
+  static cmb::detail::simd_level const level = cmb::detail::detect_simd_level();
+  return level;
+}
+
+#if defined(__GNUC__) and ( defined(__x86_64__) or defined(__i386__) )
+
+template <class Kernel, class T, class... Args>
+  [[gnu::target("avx512f,avx512bw")]]
+  auto run_avx512(T const* p, std::size_t n, Args... args)
+  {
+    if constexpr (requires { Kernel::max_bytes; })
+      return Kernel::template run<Kernel::max_bytes>(p, n, args...);
+    else
+      return Kernel::template run<64>(p, n, args...);
+  }
+
+template <class Kernel, class T, class... Args>
+  [[gnu::target("avx2")]]
+  auto run_avx2(T const* p, std::size_t n, Args... args)
+  {
+    return Kernel::template run<32>(p, n, args...);
+  }
+
+template <class Kernel, class T, class... Args>
+  [[gnu::target("sse2")]]
+  auto run_sse2(T const* p, std::size_t n, Args... args)
+  {
+    return Kernel::template run<16>(p, n, args...);
+  }
+
+#endif
+
+template <class Kernel, class T, class... Args>
+  auto run_generic(T const* p, std::size_t n, Args... args)
+  {
+    return Kernel::template run<16>(p, n, args...);
+  }
+
+// Runs Kernel over [p, p + n) with the widest instruction set the CPU
+// supports.
+template <class Kernel, class T, class... Args>
+  auto dispatch(T const* p, std::size_t n, Args... args)
+  {
+#if defined(__GNUC__) and ( defined(__x86_64__) or defined(__i386__) )
+    switch (cmb::detail::current_simd_level()) {
+      case cmb::detail::simd_level::avx512:
+        return cmb::detail::run_avx512<Kernel>(p, n, args...);
+      case cmb::detail::simd_level::avx2:
+        return cmb::detail::run_avx2<Kernel>(p, n, args...);
+      case cmb::detail::simd_level::sse2:
+        return cmb::detail::run_sse2<Kernel>(p, n, args...);
+      case cmb::detail::simd_level::generic:
+        break;
+    }
+#endif
+    return cmb::detail::run_generic<Kernel>(p, n, args...);
+  }
+
+} // namespace detail
+} // namespace cmb
+
+#pragma GCC diagnostic pop
+
+
+#endif
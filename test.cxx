@@ -1,9 +1,418 @@
 #include <iostream>
+#include <algorithm>
+#include <algorithm.hxx>
+#include <atomic>
+#include <chrono>
 #include <concepts.hxx>
+#include <ctime>
+#include <filesystem>
+#include <flat_hash_map.hxx>
+#include <fstream>
 #include <iterator.hxx>
+#include <mapped_file.hxx>
+#include <memory>
+#include <numeric.hxx>
+#include <parallel.hxx>
+#include <ranges.hxx>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vector.hxx>
+
+
+static_assert(cmb::contiguous_iterator<int*>);
+static_assert(cmb::contiguous_iterator<std::vector<int>::iterator>);
+static_assert(cmb::sortable<std::vector<int>::iterator>);
+static_assert(not cmb::segmented_iterator<int*>);
+
+static_assert([] {
+  int a[3] = { 1, 2, 3 }, b[3] = { };
+  cmb::copy(a, a + 3, b);
+  cmb::fill(a, a + 3, 0);
+  return b[2] + a[2];
+}() == 3);
+
+static_assert([] {
+  int a[4] = { 4, 2, 9, 1 };
+  return cmb::sum(a, a + 4) + cmb::count(a, a + 4, 2) + cmb::max_value(a, a + 4);
+}() == 26);
+
+static_assert(cmb::trivially_relocatable<int>);
+static_assert(not cmb::trivially_relocatable<std::string>);
+static_assert(not cmb::trivially_relocatable<int&>);
+
+static_assert(cmb::hashable<int, std::hash<int>>);
+static_assert(cmb::hashable<std::string, std::hash<std::string>>);
+static_assert(cmb::hashable<std::string const&, std::hash<std::string>>);
+static_assert(not cmb::hashable<std::vector<int>, std::hash<std::vector<int>>>);
+static_assert(not cmb::hashable<std::string, std::hash<int>>);
+static_assert(not cmb::hashable_with<int, std::string, std::hash<std::string>>);
+
+static_assert(cmb::contiguous_range<std::vector<int>>);
+static_assert(not cmb::view<std::vector<int>>);
+static_assert(not cmb::borrowed_range<std::vector<int>>);
+static_assert(cmb::borrowed_range<std::vector<int>&>);
+static_assert(cmb::contiguous_range<cmb::mapped_file<double>>);
+static_assert(cmb::borrowed_range<cmb::mapped_file<double>>);
+static_assert(cmb::view<cmb::mapped_file<double>>);
+static_assert(cmb::constructible_from<cmb::mapped_file<double>, cmb::file_mapping&>);
+static_assert(not cmb::constructible_from<cmb::mapped_file<double>, cmb::file_mapping>);
+
+
+// A forward iterator over chunks of 4 ints. end() of the last chunk is the
+// start of a spare chunk, so every position has a valid segment.
+struct chunked_iterator {
+  using iterator_concept = std::forward_iterator_tag;
+  using value_type       = int;
+  using difference_type  = std::ptrdiff_t;
+
+  int& operator*() const { return *cur; }
+
+  chunked_iterator& operator++()
+  {
+    if (++cur == *chunk + 4)
+      cur = *++chunk;
+    return *this;
+  }
+
+  chunked_iterator operator++(int) { auto t = *this; ++*this; return t; }
+
+  friend bool operator==(chunked_iterator const& a, chunked_iterator const& b) { return a.cur == b.cur; }
+
+  int* const* chunk = nullptr;
+  int*        cur   = nullptr;
+};
+
+template <>
+  struct cmb::segmented_iterator_traits<chunked_iterator> {
+    using segment_iterator = int* const*;
+    using local_iterator   = int*;
+
+    static segment_iterator segment(chunked_iterator i) { return i.chunk; }
+    static local_iterator   local(chunked_iterator i)   { return i.cur; }
+    static local_iterator   begin(segment_iterator s)   { return *s; }
+    static local_iterator   end(segment_iterator s)     { return *s + 4; }
+
+    static chunked_iterator compose(segment_iterator s, local_iterator l)
+    {
+      return l == *s + 4 ? chunked_iterator{ s + 1, s[1] } : chunked_iterator{ s, l };
+    }
+  };
+
+static_assert(cmb::segmented_iterator<chunked_iterator>);
+
+// Compares the segmented for_each, find and copy with the std algorithms on
+// every subrange of 5 chunks.
+bool check_segmented()
+{
+  int storage[6][4] = { };
+  int* const chunks[6] = { storage[0], storage[1], storage[2], storage[3], storage[4], storage[5] };
+  for (int i = 0; i < 20; ++i)
+    chunks[i / 4][i % 4] = i * 3;
+  auto at = [&](int i) { return chunked_iterator{ chunks + i / 4, chunks[i / 4] + i % 4 }; };
+
+  for (int a = 0; a <= 20; ++a)
+    for (int b = a; b <= 20; ++b) {
+      long sum = 0;
+      cmb::for_each(at(a), at(b), [&](int x) { sum += x; });
+      long expected = 0;
+      std::for_each(at(a), at(b), [&](int x) { expected += x; });
+      if (sum != expected)
+        return false;
+
+      for (int x = -3; x <= 60; x += 3)
+        if (cmb::find(at(a), at(b), x) != std::find(at(a), at(b), x))
+          return false;
+
+      std::vector<int> out(21, -1), ref(21, -1);
+      cmb::copy(at(a), at(b), out.begin());
+      std::copy(at(a), at(b), ref.begin());
+      if (out != ref)
+        return false;
+    }
+  return true;
+}
+
+
+// A move-only owner that opts in to trivially_relocatable.
+struct handle {
+  explicit handle(int v) : p{ new int(v) } { }
+  handle(handle&& other) noexcept : p{ std::exchange(other.p, nullptr) } { }
+  handle& operator=(handle&& other) noexcept { std::swap(p, other.p); return *this; }
+  ~handle() { delete p; }
+  int* p;
+};
+
+template <>
+  inline constexpr bool cmb::enable_trivially_relocatable<handle> = true;
+
+static_assert(cmb::trivially_relocatable<handle>);
+
+// A copyable type whose move constructor throws on the fourth move after
+// moves are armed.
+struct throwing_move {
+  static inline int moves = -1;
+  explicit throwing_move(int v) : s{ std::to_string(v) } { }
+  throwing_move(throwing_move const&) = default;
+  throwing_move(throwing_move&& other) : s{ std::move(other.s) }
+  {
+    if (moves >= 0 and ++moves == 4)
+      throw 4;
+  }
+  throwing_move& operator=(throwing_move const&) = default;
+  std::string s;
+};
+
+
+// A value whose copy constructor throws once copies are armed and the
+// countdown reaches zero.
+struct throwing_copy {
+  static inline int copies_left = -1;
+  throwing_copy() = default;
+  throwing_copy(throwing_copy const&)
+  {
+    if (copies_left >= 0 and copies_left-- == 0)
+      throw 0;
+  }
+  throwing_copy& operator=(throwing_copy const&) = default;
+  std::string s = std::string(40, 'x');
+};
+
+
+// A hash function that counts its calls.
+struct counting_hash {
+  static inline int calls = 0;
+  std::size_t operator()(int x) const
+  {
+    ++calls;
+    return std::hash<int>{ }(x);
+  }
+};
+
+
+// A hash function that throws once calls are armed and the countdown
+// reaches zero.
+struct throwing_hash {
+  static inline int calls_left = -1;
+  std::size_t operator()(int x) const
+  {
+    if (calls_left >= 0 and calls_left-- == 0)
+      throw 0;
+    return std::hash<int>{ }(x);
+  }
+};
 
 
 int main()
 {
+  int a[64], b[64];
+  for (int i = 0; i < 64; ++i)
+    a[i] = i;
+  std::vector<int> c(64), e(64);
+  if (cmb::copy(a, a + 64, b) != b + 64 or b[63] != 63 or
+      cmb::copy(a, a + 64, c.begin()) != c.end() or c[63] != 63 or
+      cmb::move(c.begin(), c.end(), e.begin()) != e.end() or e != c)
+    return 1;
+  cmb::fill(b, b + 64, -1);
+  cmb::fill(c.begin(), c.end(), 1);
+  if (std::count(b, b + 64, -1) != 64 or std::count(c.begin(), c.end(), 1) != 64)
+    return 1;
+
+  // volatile ranges are copied and filled element by element
+  volatile int va[4] = { 1, 2, 3, 4 };
+  int vb[4] = { };
+  volatile int vc[4] = { };
+  cmb::copy(va, va + 4, vb);
+  cmb::move(vb, vb + 4, vc);
+  cmb::fill(va, va + 4, 7);
+  if (vb[3] != 4 or vc[0] != 1 or vc[3] != 4 or va[0] != 7 or va[3] != 7)
+    return 1;
+
+  std::allocator<int> ints;
+  int* u = ints.allocate(64);
+  if (cmb::uninitialized_copy(c.begin(), c.end(), u) != u + 64 or not std::equal(u, u + 64, c.begin()))
+    return 1;
+  ints.deallocate(u, 64);
+
+  std::string s[3] = { "a", "bb", std::string(40, 'c') };
+  std::allocator<std::string> strings;
+  std::string* t = strings.allocate(3);
+  cmb::uninitialized_copy(s, s + 3, t);
+  if (not std::equal(s, s + 3, t))
+    return 1;
+  std::destroy(t, t + 3);
+  strings.deallocate(t, 3);
+
+  if (not check_segmented())
+    return 1;
+
+  cmb::vector<int> r;
+  for (int i = 0; i < 1000; ++i)
+    r.push_back(i);
+  if (r.size() != 1000 or r[0] != 0 or r[999] != 999)
+    return 1;
+
+  cmb::vector<handle> hv;
+  for (int i = 0; i < 1000; ++i)
+    hv.emplace_back(i);
+  if (hv.size() != 1000 or *hv[0].p != 0 or *hv[999].p != 999)
+    return 1;
+
+  alignas(handle) unsigned char raw[sizeof(handle)];
+  handle* moved = cmb::relocate(&hv.back(), reinterpret_cast<handle*>(raw));
+  hv.back().p = nullptr;
+  if (*moved->p != 999)
+    return 1;
+  std::destroy_at(moved);
+
+  cmb::vector<throwing_move> tv;
+  for (int i = 0; i < 8; ++i)
+    tv.emplace_back(i);
+  throwing_move const ninth(8);
+  throwing_move::moves = 0;
+  try {
+    tv.push_back(ninth);
+  }
+  catch (int) { }
+  throwing_move::moves = -1;
+  for (int i = 0; i < 8; ++i)
+    if (tv[static_cast<std::size_t>(i)].s != std::to_string(i))
+      return 1;
+
+  cmb::vector<std::string> v;
+  for (int i = 0; i < 100; ++i)
+    v.push_back(std::to_string(i));
+  v.push_back(v.front());
+  if (v.size() != 101 or v[99] != "99" or v.back() != "0")
+    return 1;
+
+  // volatile elements are read one at a time instead of by the kernels
+  volatile int w[4] = { 4, 3, 9, 3 };
+  if (cmb::find(w, w + 4, 3) != w + 1 or cmb::count(w, w + 4, 3) != 2 or
+      cmb::sum(w, w + 4) != 19 or cmb::max_value(w, w + 4) != 9)
+    return 1;
+
+  std::vector<double> d(1000, 0.5);
+  d[700] = -1.0;
+  if (cmb::sum(d.begin(), d.end(), cmb::fp_order::reassociate) != 498.5 or
+      cmb::min_value(d.begin(), d.end(), cmb::fp_order::reassociate) != -1.0 or
+      cmb::find(d.begin(), d.end(), -1.0) != d.begin() + 700 or
+      cmb::count(d.begin(), d.end(), 0.5) != 999)
+    return 1;
+
+  cmb::parallel::thread_pool pool(4);
+  std::vector<int> p(100000);
+  for (std::size_t i = 0; i < p.size(); ++i)
+    p[i] = static_cast<int>(i * 7919 % p.size());
+  cmb::parallel::sort(pool, p.begin(), p.end());
+  cmb::parallel::for_each(pool, p.begin(), p.end(), [](int& x) { x *= 2; });
+  if (not std::is_sorted(p.begin(), p.end()) or
+      cmb::parallel::transform_reduce(pool, p.begin(), p.end(), 0L, std::plus<>{ },
+                                      [](int x) { return long{ x }; }) != 9999900000L)
+    return 1;
+
+  // more elements than one grain, so the blocks are merged through the buffer;
+  // in descending order a moved-from string sorts last and breaks the merges
+  std::vector<std::string> ps(50000);
+  for (std::size_t i = 0; i < ps.size(); ++i)
+    ps[i] = std::to_string(i * 7919 % ps.size());
+  std::vector<std::string> sorted(ps);
+  std::sort(sorted.begin(), sorted.end(), std::greater<>{ });
+  cmb::parallel::sort(pool, ps.begin(), ps.end(), std::ranges::greater{ });
+  if (ps != sorted)
+    return 1;
+
+  // a task_group waiting on a task that runs on a worker sleeps rather than
+  // spinning, so it uses far less processor time than the task takes
+  {
+    std::atomic<bool> started = false;
+    cmb::parallel::task_group g(pool);
+    g.run([&] {
+      started = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    });
+    while (not started)
+      std::this_thread::yield();
+    std::clock_t const before = std::clock();
+    g.wait();
+    if (std::clock() - before > CLOCKS_PER_SEC / 20)
+      return 1;
+  }
+
+  struct record { int id; double value; };
+  auto const path = std::filesystem::temp_directory_path() / "cmb_test_records.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    for (int i = 0; i < 100; ++i) {
+      record const rec{ i, i * 0.5 };
+      out.write(reinterpret_cast<char const*>(&rec), sizeof rec);
+    }
+  }
+  {
+    cmb::file_mapping const mapping(path.string());
+    cmb::mapped_file<record> const records(mapping);
+    if (records.size() != 100 or records[0].id != 0 or records[99].id != 99 or records[99].value != 49.5)
+      return 1;
+    // 1600 bytes are not a whole number of 3-byte records
+    bool thrown = false;
+    try {
+      cmb::mapped_file<char[3]> const triples(mapping);
+    }
+    catch (std::length_error const&) {
+      thrown = true;
+    }
+    if (not thrown)
+      return 1;
+  }
+  std::filesystem::remove(path);
+
+  cmb::flat_hash_map<std::string, int> h;
+  for (int i = 0; i < 1000; ++i)
+    h[std::to_string(i)] = i;
+  for (int i = 0; i < 1000; i += 2)
+    h.erase(std::to_string(i));
+  if (h.size() != 500 or h.contains("10") or h.at("11") != 11)
+    return 1;
+
+  // inserting a new key hashes it once; finding an existing one does too
+  cmb::flat_hash_map<int, int, counting_hash> ch;
+  ch.reserve(100);
+  for (int i = 0; i < 100; ++i)
+    ch[i] = i;
+  ch[7] = 8;
+  if (counting_hash::calls != 101 or ch.size() != 100 or ch.at(7) != 8)
+    return 1;
+
+  // a hash that throws while the table grows leaves the map unchanged
+  cmb::flat_hash_map<int, int, throwing_hash> th;
+  for (int i = 0; i < 14; ++i)
+    th[i] = i;
+  std::size_t const full = th.capacity();
+  throwing_hash::calls_left = 5;
+  try {
+    th[100] = 100;
+    return 1;
+  }
+  catch (int) { }
+  throwing_hash::calls_left = -1;
+  if (th.size() != 14 or th.capacity() != full or th.contains(100))
+    return 1;
+  for (int i = 0; i < 14; ++i)
+    if (not th.contains(i) or th.at(i) != i)
+      return 1;
+
+  // a copy that throws halfway frees what it has built, as ASan checks
+  cmb::flat_hash_map<int, throwing_copy> tc;
+  for (int i = 0; i < 100; ++i)
+    tc[i];
+  throwing_copy::copies_left = 50;
+  try {
+    cmb::flat_hash_map<int, throwing_copy> copy(tc);
+    return 1;
+  }
+  catch (int) { }
+  throwing_copy::copies_left = -1;
+
   std::cout << "\nCompiles without error." << std::endl;
 }
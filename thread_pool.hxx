@@ -0,0 +1,235 @@
+#ifndef THREAD_POOL_HXX
+#define THREAD_POOL_HXX
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <concepts.hxx>
+
+
+namespace cmb      {
+namespace parallel {
+
+//
+// class thread_pool
+// A work-stealing pool with a concurrency of n: n - 1 worker threads plus
+// the thread that waits on a task_group, which runs queued tasks while it
+// waits. Every participant owns a queue; it runs its own tasks newest
+// first and steals the oldest tasks of the others when it runs out.
+
+CMB_EXPORT class thread_pool {
+public:
+  explicit thread_pool(std::size_t concurrency = std::thread::hardware_concurrency())
+    : queues_(concurrency == 0 ? 1 : concurrency)
+  {
+    for (std::size_t i = 1; i < queues_.size(); ++i)
+      workers_.emplace_back([this, i] { work(i); });
+  }
+
+  thread_pool(thread_pool const&) = delete;
+  thread_pool& operator=(thread_pool const&) = delete;
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stopping_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& worker : workers_)
+      worker.join();
+  }
+
+  // number of threads that run tasks, including the waiting thread
+  std::size_t concurrency() const noexcept { return queues_.size(); }
+
+  // Queues f. Tasks submitted from a worker go to that worker's queue;
+  // tasks submitted from any other thread go to the shared queue 0.
+  void submit(std::function<void()> f)
+  {
+    std::size_t const self = index();
+    {
+      std::lock_guard<std::mutex> lock(queues_[self].mutex);
+      queues_[self].tasks.push_back(std::move(f));
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      ++queued_;
+    }
+    sleep_cv_.notify_one();
+  }
+
+  // Runs one queued task on the calling thread. Returns false if there was
+  // none to run.
+  bool run_one()
+  {
+    std::function<void()> f;
+    if (not take(index(), f))
+      return false;
+    f();
+    return true;
+  }
+
+private:
+  struct queue {
+    std::mutex                        mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  // queue owned by the calling thread
+  std::size_t index() const noexcept
+  {
+    return current_pool() == this ? current_index() : 0;
+  }
+
+  bool take(std::size_t self, std::function<void()>& f)
+  {
+    {
+      std::lock_guard<std::mutex> lock(queues_[self].mutex);
+      if (not queues_[self].tasks.empty()) {
+        f = std::move(queues_[self].tasks.back());
+        queues_[self].tasks.pop_back();
+        --queued_;
+        return true;
+      }
+    }
+    for (std::size_t k = 1; k < queues_.size(); ++k) {
+      auto& victim = queues_[(self + k) % queues_.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (not victim.tasks.empty()) {
+        f = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queued_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void work(std::size_t self)
+  {
+    current_pool()  = this;
+    current_index() = self;
+
+    std::function<void()> f;
+    for (;;) {
+      if (take(self, f)) {
+        f();
+        f = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleep_cv_.wait(lock, [this] { return stopping_ or queued_ > 0; });
+      if (stopping_ and queued_ <= 0)
+        return;
+    }
+  }
+
+  static thread_pool const*& current_pool() noexcept
+  {
+    thread_local thread_pool const* pool = nullptr;
+    return pool;
+  }
+
+  static std::size_t& current_index() noexcept
+  {
+    thread_local std::size_t i = 0;
+    return i;
+  }
+
+  std::vector<queue>          queues_;
+  std::vector<std::thread>    workers_;
+
+  std::mutex                  sleep_mutex_;
+  std::condition_variable     sleep_cv_;
+  std::atomic<std::ptrdiff_t> queued_   = 0;
+  bool                        stopping_ = false;
+};
+
+
+//
+// class task_group
+// Runs tasks on a thread_pool and waits for all of them to finish. The
+// waiting thread runs queued tasks while there are any, then sleeps until
+// the tasks still running on other threads are done. The first exception
+// thrown by a task is rethrown by wait.
+
+CMB_EXPORT class task_group {
+public:
+  explicit task_group(cmb::parallel::thread_pool& pool) noexcept
+    : pool_{ pool }
+  { }
+
+  task_group(task_group const&) = delete;
+  task_group& operator=(task_group const&) = delete;
+
+  ~task_group()
+  {
+    join();
+  }
+
+  template <class F>
+    void run(F f)
+    {
+      ++pending_;
+      pool_.submit([this, f = std::move(f)]() mutable {
+        try {
+          f();
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (not error_)
+            error_ = std::current_exception();
+        }
+        // The last task notifies while holding the mutex, so join cannot
+        // return, and the group be destroyed, before the task is done with it.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0)
+          done_.notify_all();
+      });
+    }
+
+  void wait()
+  {
+    join();
+    if (error_)
+      std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+
+private:
+  void join()
+  {
+    while (pending_ > 0 and pool_.run_one())
+      ;
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+  cmb::parallel::thread_pool& pool_;
+  std::atomic<std::size_t>    pending_ = 0;
+  std::mutex                  mutex_;
+  std::condition_variable     done_;
+  std::exception_ptr          error_;
+};
+
+
+// function default_pool
+// The pool used by the parallel algorithms when none is given.
+CMB_EXPORT inline cmb::parallel::thread_pool& default_pool()
+{
+  static cmb::parallel::thread_pool pool;
+  return pool;
+}
+
+} // namespace parallel
+} // namespace cmb
+
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef VECTOR_HXX
+#define VECTOR_HXX
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <algorithm.hxx>
+
+
+namespace cmb    {
+namespace detail {
+
+//
+// helper concept reallocatable
+
+// Storage for T can be grown with std::realloc when T is trivially
+// relocatable and malloc's alignment guarantee covers it.
+template <class T>
+  concept reallocatable =
+    cmb::trivially_relocatable<T> and
+    alignof(T) <= alignof(std::max_align_t);
+
+} // namespace detail
+
+
+//
+// class template vector
+// A minimal contiguous container that grows by relocating its elements.
+// Trivially relocatable element types are reallocated in place with
+// std::realloc; others are relocated element by element into new storage,
+// or copied if their move constructor may throw.
+
+CMB_EXPORT template <class T>
+  requires std::is_object_v<T> and cmb::destructible<T>
+  class vector {
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = T const&;
+    using pointer         = T*;
+    using const_pointer   = T const*;
+    using iterator        = T*;
+    using const_iterator  = T const*;
+
+    vector() noexcept = default;
+
+    vector(vector const& other)
+      requires cmb::copy_constructible<T>
+    {
+      reserve(other.size_);
+      try {
+        end_of(cmb::uninitialized_copy(other.begin(), other.end(), data_));
+      }
+      catch (...) {
+        deallocate(data_);
+        throw;
+      }
+    }
+
+    vector(vector&& other) noexcept
+      : data_{ std::exchange(other.data_, nullptr) },
+        size_{ std::exchange(other.size_, 0) },
+        capacity_{ std::exchange(other.capacity_, 0) }
+    { }
+
+    vector& operator=(vector const& other)
+      requires cmb::copy_constructible<T>
+    {
+      if (this != &other) {
+        vector copy(other);
+        swap(copy);
+      }
+      return *this;
+    }
+
+    vector& operator=(vector&& other) noexcept
+    {
+      vector moved(std::move(other));
+      swap(moved);
+      return *this;
+    }
+
+    ~vector()
+    {
+      clear();
+      deallocate(data_);
+    }
+
+    // element access
+    reference       operator[](size_type n)       noexcept { return data_[n]; }
+    const_reference operator[](size_type n) const noexcept { return data_[n]; }
+
+    reference       front()       noexcept { return data_[0]; }
+    const_reference front() const noexcept { return data_[0]; }
+    reference       back()        noexcept { return data_[size_ - 1]; }
+    const_reference back()  const noexcept { return data_[size_ - 1]; }
+
+    pointer       data()       noexcept { return data_; }
+    const_pointer data() const noexcept { return data_; }
+
+    // iterators
+    iterator       begin()       noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    iterator       end()         noexcept { return data_ + size_; }
+    const_iterator end()   const noexcept { return data_ + size_; }
+
+    // capacity
+    bool      empty()    const noexcept { return size_ == 0; }
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    void reserve(size_type n)
+      requires cmb::move_constructible<T>
+    {
+      if (n > capacity_)
+        grow(n);
+    }
+
+    // modifiers
+    template <class... Args>
+      requires cmb::constructible_from<T, Args...> and cmb::move_constructible<T>
+      reference emplace_back(Args&&... args)
+      {
+        if (size_ == capacity_) {
+          // args may refer to an element of this vector, so construct the
+          // new element before the storage is relocated
+          T value(std::forward<Args>(args)...);
+          grow(next_capacity());
+          return *::new (static_cast<void*>(data_ + size_++)) T(std::move(value));
+        }
+        return *::new (static_cast<void*>(data_ + size_++)) T(std::forward<Args>(args)...);
+      }
+
+    void push_back(T const& value)
+      requires cmb::copy_constructible<T>
+    {
+      emplace_back(value);
+    }
+
+    void push_back(T&& value)
+      requires cmb::move_constructible<T>
+    {
+      emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept
+    {
+      std::destroy_at(data_ + --size_);
+    }
+
+    void clear() noexcept
+    {
+      std::destroy(data_, data_ + size_);
+      size_ = 0;
+    }
+
+    void swap(vector& other) noexcept
+    {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    }
+
+  private:
+    size_type next_capacity() const noexcept
+    {
+      return capacity_ == 0 ? 8 : 2 * capacity_;
+    }
+
+    void end_of(T* last) noexcept
+    {
+      size_ = static_cast<size_type>(last - data_);
+    }
+
+    void grow(size_type n)
+    {
+      if constexpr (cmb::detail::reallocatable<T>) {
+        void* p = std::realloc(static_cast<void*>(data_), n * sizeof(T));
+        if (p == nullptr)
+          throw std::bad_alloc();
+        data_ = static_cast<T*>(p);
+      }
+      else {
+        // As std::vector does, elements whose move constructor may throw
+        // are copied, so a failed growth leaves the vector unchanged.
+        T* p = allocate(n);
+        try {
+          if constexpr (std::is_nothrow_move_constructible_v<T> or not cmb::copy_constructible<T>) {
+            cmb::uninitialized_relocate(data_, data_ + size_, p);
+          }
+          else {
+            cmb::uninitialized_copy(data_, data_ + size_, p);
+            std::destroy(data_, data_ + size_);
+          }
+        }
+        catch (...) {
+          deallocate(p);
+          throw;
+        }
+        deallocate(data_);
+        data_ = p;
+      }
+      capacity_ = n;
+    }
+
+    static T* allocate(size_type n)
+    {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+    }
+
+    static void deallocate(T* p) noexcept
+    {
+      if constexpr (cmb::detail::reallocatable<T>)
+        std::free(p);
+      else
+        ::operator delete(p, std::align_val_t{ alignof(T) });
+    }
+
+    T*        data_     = nullptr;
+    size_type size_     = 0;
+    size_type capacity_ = 0;
+  };
+
+} // namespace cmb
+
+
+#endif